@@ -0,0 +1,216 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   A L L O C A T I O N   T R A C K E R   C L A S S                                        */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "allocation_tracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+#include <new>
+#include <malloc.h>
+#endif
+
+//--Process wide counters, updated by operator new and delete while allocations are tracked--//
+static atomic<unsigned long> allocation_count(0);
+static atomic<unsigned long> allocated_bytes(0);
+static atomic<unsigned long> live_bytes(0);
+static atomic<unsigned long> peak_live_bytes(0);
+
+#ifdef TRACK_ALLOCATIONS
+
+// void* operator new(size_t) method
+
+/// Replaces the global allocation function, counting the allocation and the bytes malloc hands out for it.
+/// @param size Bytes requested.
+
+void* operator new(size_t size)
+{
+    void* block = malloc(size ? size : 1);
+
+    if(!block)
+    {
+        throw bad_alloc();
+    }
+
+    const unsigned long bytes = malloc_usable_size(block);
+
+    allocation_count.fetch_add(1, memory_order_relaxed);
+    allocated_bytes.fetch_add(bytes, memory_order_relaxed);
+
+    const unsigned long live = live_bytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+    unsigned long peak = peak_live_bytes.load(memory_order_relaxed);
+
+    while(live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, memory_order_relaxed))
+    {
+    }
+
+    return block;
+}
+
+
+// void* operator new[](size_t) method
+
+/// Replaces the global array allocation function.
+/// @param size Bytes requested.
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+
+// void operator delete(void*) method
+
+/// Replaces the global deallocation function, releasing the bytes of the block from the live bytes.
+/// @param block Block returned by operator new.
+
+void operator delete(void* block) noexcept
+{
+    if(block)
+    {
+        live_bytes.fetch_sub(malloc_usable_size(block), memory_order_relaxed);
+        free(block);
+    }
+}
+
+
+// void operator delete[](void*) method
+
+/// Replaces the global array deallocation function.
+/// @param block Block returned by operator new[].
+
+void operator delete[](void* block) noexcept
+{
+    operator delete(block);
+}
+
+#endif // TRACK_ALLOCATIONS
+
+
+// CONSTRUCTOR
+
+/// Creates an Allocation Tracker object with no stages.
+
+Allocation_Tracker::Allocation_Tracker(void)
+{
+    stage_name = NULL;
+    stage_start = 0.0;
+    start_count = 0;
+    start_bytes = 0;
+    start_live = 0;
+}
+
+
+// void begin_stage(const char* const) method
+
+/// This method starts a stage. The peak of the live bytes is restarted from the bytes live now.
+/// @param name Name of the stage, shown by show_stages(). A string literal, as it also names the trace span of the stage.
+
+void Allocation_Tracker::begin_stage(const char* const name)
+{
+    Stage_Allocations stage;
+    stage.name = name;
+    stage.count = 0;
+    stage.bytes = 0;
+    stage.peak = 0;
+    stage.retained = 0;
+
+    stages.push_back(stage);
+
+    start_count = allocation_count.load();
+    start_bytes = allocated_bytes.load();
+    start_live = live_bytes.load();
+    peak_live_bytes.store(start_live);
+
+    stage_name = name;
+    stage_start = Trace_Recorder::now();
+}
+
+
+// void end_stage(void) method
+
+/// This method ends the stage started last, recording its allocations.
+
+void Allocation_Tracker::end_stage(void)
+{
+    if(stages.empty())
+    {
+        cerr << "SignalAnalyzer Error: AllocationTracker class." << endl
+             << "void end_stage(void) method" << endl
+             << "No stage was started" << endl;
+
+        exit(1);
+    }
+
+    Stage_Allocations& stage = stages.back();
+    stage.count = allocation_count.load() - start_count;
+    stage.bytes = allocated_bytes.load() - start_bytes;
+    stage.peak = peak_live_bytes.load();
+    stage.retained = (long)live_bytes.load() - (long)start_live;
+
+    Trace_Recorder::record(stage_name, "stage", stage_start);
+}
+
+
+// void show_stages(void) const method
+
+/// This method shows the allocations of every stage, and the peak resident set size of the process.
+/// Nothing is shown unless allocations are tracked.
+
+void Allocation_Tracker::show_stages(void) const
+{
+    if(!is_enabled())
+    {
+        return;
+    }
+
+    cout << endl << "         Memory Usage" << endl;
+
+    for(unsigned int i=0; i<stages.size(); i++)
+    {
+        cout << stages[i].name << ": Allocations = " << stages[i].count
+             << "   Allocated = " << stages[i].bytes/BYTES_PER_MB << " MB"
+             << "   Peak live = " << stages[i].peak/BYTES_PER_MB << " MB"
+             << "   Retained = " << stages[i].retained/BYTES_PER_MB << " MB" << endl;
+    }
+
+    cout << "Peak RSS = " << get_peak_rss()/BYTES_PER_MB << " MB" << endl;
+}
+
+
+// bool is_enabled(void) method
+
+/// This method returns true if the program was built to track allocations.
+
+bool Allocation_Tracker::is_enabled(void)
+{
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+// unsigned long get_peak_rss(void) method
+
+/// This method returns the peak resident set size of the process so far, in bytes.
+
+unsigned long Allocation_Tracker::get_peak_rss(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    //--Kilobytes on Linux--//
+    return (unsigned long)usage.ru_maxrss * 1024;
+}
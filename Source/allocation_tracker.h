@@ -0,0 +1,73 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   A L L O C A T I O N   T R A C K E R   C L A S S   H E A D E R                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include "trace_recorder.h"
+
+using namespace std;
+
+#define BYTES_PER_MB (1024.0*1024.0)
+
+//--Heap allocations made between the start and the end of a stage of the analysis--//
+struct Stage_Allocations
+{
+    string name;
+    unsigned long count;
+    unsigned long bytes;        // Bytes allocated
+    unsigned long peak;         // Peak live bytes of the process during the stage
+    long retained;              // Live bytes at the end of the stage less those at its start
+};
+
+/// Opt-in accounting of heap allocations, to size machines and check memory optimizations.
+/// Built with -DTRACK_ALLOCATIONS=ON, the global operator new and delete count every allocation, the bytes
+/// allocated and the live bytes, and record the peak of the live bytes. A tracker splits the run into stages
+/// and reports each of them, together with the peak resident set size of the process. Without the option
+/// allocations are not counted, at no cost, and nothing is reported. Stages also appear as spans on the
+/// trace timeline, when one is recorded.
+
+class Allocation_Tracker
+{
+public:
+    Allocation_Tracker(void);
+
+    void begin_stage(const char* const);
+    void end_stage(void);
+
+    void show_stages(void) const;
+
+    static bool is_enabled(void);
+    static unsigned long get_peak_rss(void);
+
+private:
+    vector<Stage_Allocations> stages;
+
+    //--Counters at the start of the open stage--//
+    const char* stage_name;
+    double stage_start;
+    unsigned long start_count;
+    unsigned long start_bytes;
+    unsigned long start_live;
+};
+
+#endif // ALLOCATION_TRACKER_H
@@ -0,0 +1,604 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   A N A L Y S I S   D A E M O N   C L A S S                                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+
+#include "analysis_daemon.h"
+
+// CONSTRUCTOR
+
+/// Creates an Analysis Daemon object, serving queries on an already filtered Signal Analyzer List.
+/// The window index over the extrema and phase differences of the signals, and the cycle series of every signal,
+/// are built once here and kept resident, so that each query is answered from memory.
+/// @param signalList Signal Analyzer List holding the signals.
+/// @param socketPath Path of the Unix domain socket to listen on.
+/// @param no_threads Number of threads serving clients. Zero selects the number of hardware threads.
+
+Analysis_Daemon::Analysis_Daemon(const Signal_Analyzer_List& signalList, const char* const socketPath, const unsigned int no_threads)
+    : sList(signalList), pool(no_threads), index(signalList)
+{
+    socket_path = socketPath;
+    listen_fd = -1;
+    stopping = false;
+    wake_fd[0] = -1;
+    wake_fd[1] = -1;
+
+    for(unsigned int i=0; i<sList.get_no_of_signals(); i++)
+    {
+        cycles.push_back(sList.get_signal(i).calculate_cycle_series());
+    }
+}
+
+
+// DESTRUCTOR
+
+/// Closes the listening socket and removes its path.
+
+Analysis_Daemon::~Analysis_Daemon()
+{
+    if(listen_fd >= 0)
+    {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+    for(unsigned int i=0; i<2; i++)
+    {
+        if(wake_fd[i] >= 0)
+        {
+            close(wake_fd[i]);
+        }
+    }
+}
+
+
+// void run(void) method
+
+/// This method listens on the Unix domain socket, and polls the listening socket and every client on this thread.
+/// Only complete request lines are handed to the thread pool, so a client that stays connected without sending
+/// holds no worker. Returns after a client sends the SHUTDOWN request, once the requests already received have been
+/// answered. The clients still connected are then disconnected.
+/// Each client sends requests of one line each, and receives one line per request, starting with "OK" or "ERR".
+/// <ul>
+/// <li> SIGNALS: IDs of the signals on the list.
+/// <li> AMPLITUDE id [t0 t1], OFFSET id [t0 t1]: Average amplitude or offset of a signal.
+/// <li> FREQUENCY id [t0 t1] [CREST|TROUGH]: Average frequency of a signal. Trough based by default.
+/// <li> RANGE id [t0 t1]: Crest and trough of a signal on the amplitude-axis.
+/// <li> PHASE id_1 id_2 [t0 t1] [CREST|TROUGH]: Circular mean of the phase difference, in (-180°,180°], of signal id_1
+///      W.R.T signal id_2, and the number of phase difference samples averaged. Trough based by default.
+/// <li> CYCLE id t: Time, amplitude, offset and frequency of the cycle of a signal closest to time t.
+/// <li> QUIT: Closes the connection.
+/// <li> SHUTDOWN: Stops the daemon.
+/// </ul>
+/// The optional time window [t0,t1] restricts a request to the extrema within the window. It defaults to the whole recording.
+
+void Analysis_Daemon::run(void)
+{
+    struct sockaddr_un address;
+
+    if(socket_path.size() >= sizeof(address.sun_path))
+    {
+        cerr << "SignalAnalyzer Error: AnalysisDaemon class." << endl
+             << "void run(void) method" << endl
+             << "Socket path too long: " << socket_path << endl;
+
+        exit(1);
+    }
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listen_fd < 0)
+    {
+        cerr << "SignalAnalyzer Error: AnalysisDaemon class." << endl
+             << "void run(void) method" << endl
+             << "Cannot create socket: " << strerror(errno) << endl;
+
+        exit(1);
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path)-1);
+
+    unlink(socket_path.c_str());
+    if(::bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listen_fd, DAEMON_BACKLOG) < 0)
+    {
+        cerr << "SignalAnalyzer Error: AnalysisDaemon class." << endl
+             << "void run(void) method" << endl
+             << "Cannot listen on socket: " << socket_path << ": " << strerror(errno) << endl;
+
+        exit(1);
+    }
+
+    if(pipe(wake_fd) < 0)
+    {
+        cerr << "SignalAnalyzer Error: AnalysisDaemon class." << endl
+             << "void run(void) method" << endl
+             << "Cannot create pipe: " << strerror(errno) << endl;
+
+        exit(1);
+    }
+
+    cout << endl << "Analysis daemon listening on: " << socket_path << endl;
+
+    vector<Daemon_Client> clients;
+
+    while(!stopping)
+    {
+        //--The listening socket, the pipe of the pool, then the clients not waiting on the pool--//
+        vector<struct pollfd> descriptors(2);
+        vector<unsigned int> polled;
+
+        descriptors[0].fd = listen_fd;
+        descriptors[1].fd = wake_fd[0];
+
+        for(unsigned int i=0; i<clients.size(); i++)
+        {
+            if(!clients[i].busy)
+            {
+                struct pollfd descriptor;
+                descriptor.fd = clients[i].fd;
+                descriptors.push_back(descriptor);
+                polled.push_back(i);
+            }
+        }
+        for(unsigned int i=0; i<descriptors.size(); i++)
+        {
+            descriptors[i].events = POLLIN;
+            descriptors[i].revents = 0;
+        }
+
+        if(poll(&descriptors[0], descriptors.size(), -1) < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        if(descriptors[1].revents)
+        {
+            finish_requests(clients);
+        }
+
+        for(unsigned int k=0; k<polled.size(); k++)
+        {
+            if(descriptors[2+k].revents)
+            {
+                read_requests(clients[polled[k]]);
+            }
+        }
+
+        if(descriptors[0].revents && !stopping)
+        {
+            const int client_fd = accept(listen_fd, NULL, NULL);
+
+            if(client_fd >= 0)
+            {
+                clients.push_back(Daemon_Client(client_fd));
+            }
+            else if(errno != EINTR && errno != ECONNABORTED)
+            {
+                break;
+            }
+        }
+
+        //--Drop the disconnected clients--//
+        unsigned int kept = 0;
+        for(unsigned int i=0; i<clients.size(); i++)
+        {
+            if(clients[i].fd >= 0)
+            {
+                clients[kept++] = clients[i];
+            }
+        }
+        clients.resize(kept);
+    }
+
+    pool.wait();
+
+    for(unsigned int i=0; i<clients.size(); i++)
+    {
+        close(clients[i].fd);
+    }
+
+    cout << "Analysis daemon stopped" << endl;
+}
+
+
+// void read_requests(Daemon_Client&) method
+
+/// This method receives what a client has sent, and hands its complete request lines to the thread pool as one batch.
+/// The client is disconnected if it has closed the connection, or if a line grows beyond DAEMON_MAX_REQUEST bytes.
+/// @param client Client with bytes to be received.
+
+void Analysis_Daemon::read_requests(Daemon_Client& client)
+{
+    char buffer[DAEMON_MAX_REQUEST];
+
+    const ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+    if(received <= 0)
+    {
+        if(received < 0 && errno == EINTR)
+        {
+            return;
+        }
+
+        close(client.fd);
+        client.fd = -1;
+        return;
+    }
+    client.pending.append(buffer, received);
+
+    vector<string> requests;
+    size_t end_of_line;
+
+    while((end_of_line = client.pending.find('\n')) != string::npos)
+    {
+        requests.push_back(client.pending.substr(0, end_of_line));
+        client.pending.erase(0, end_of_line+1);
+    }
+
+    if(client.pending.size() > DAEMON_MAX_REQUEST)
+    {
+        close(client.fd);
+        client.fd = -1;
+        return;
+    }
+
+    if(!requests.empty())
+    {
+        client.busy = true;
+        pool.submit(std::bind(&Analysis_Daemon::serve_requests, this, client.fd, requests));
+    }
+}
+
+
+// void serve_requests(const int, const vector<string>&) method
+
+/// This method answers a batch of request lines of a client, on a pool thread, writing one response line per request.
+/// It then reports on the pipe of the pool whether the client stays connected: its socket if it does, and the socket
+/// negated, minus one, if it sent QUIT or can no longer be written to.
+/// @param client_fd Socket of the client.
+/// @param requests Request lines, without the end of line.
+
+void Analysis_Daemon::serve_requests(const int client_fd, const vector<string>& requests)
+{
+    bool connected = true;
+
+    for(unsigned int i=0; connected && i<requests.size(); i++)
+    {
+        if(requests[i] == "QUIT")
+        {
+            connected = false;
+            break;
+        }
+
+        const string response = answer(requests[i]) + "\n";
+        if(send(client_fd, response.c_str(), response.size(), MSG_NOSIGNAL) < 0)
+        {
+            connected = false;
+        }
+    }
+
+    const int report = connected ? client_fd : -client_fd-1;
+    if(write(wake_fd[1], &report, sizeof(report)) < 0)
+    {
+        cerr << "SignalAnalyzer Error: AnalysisDaemon class." << endl
+             << "void serve_requests(const int, const vector<string>&) method" << endl
+             << "Cannot write to pipe: " << strerror(errno) << endl;
+
+        exit(1);
+    }
+}
+
+
+// void finish_requests(vector<Daemon_Client>&) method
+
+/// This method reads the reports of the batches answered by the pool, polls those clients again, and disconnects
+/// the ones that sent QUIT.
+/// @param clients Connected clients.
+
+void Analysis_Daemon::finish_requests(vector<Daemon_Client>& clients)
+{
+    int reports[DAEMON_BACKLOG];
+
+    const ssize_t received = read(wake_fd[0], reports, sizeof(reports));
+
+    for(ssize_t r=0; r<received/(ssize_t)sizeof(int); r++)
+    {
+        const int client_fd = reports[r] >= 0 ? reports[r] : -reports[r]-1;
+
+        for(unsigned int i=0; i<clients.size(); i++)
+        {
+            if(clients[i].fd == client_fd)
+            {
+                clients[i].busy = false;
+
+                if(reports[r] < 0)
+                {
+                    close(client_fd);
+                    clients[i].fd = -1;
+                }
+                break;
+            }
+        }
+    }
+}
+
+
+// string answer(const string&) method
+
+/// This method answers a single request line. See run() for the request protocol.
+/// @param request Request line, without the end of line.
+
+string Analysis_Daemon::answer(const string& request)
+{
+    istringstream ssRequest(request);
+    ostringstream ssResponse;
+    string command;
+
+    ssResponse << setprecision(10);
+    ssRequest >> command;
+
+    if(command == "SIGNALS")
+    {
+        ssResponse << "OK";
+        for(unsigned int i=0; i<sList.get_no_of_signals(); i++)
+        {
+            ssResponse << " " << sList.get_signal(i).get_signal_id();
+        }
+    }
+    else if(command == "AMPLITUDE" || command == "OFFSET" || command == "FREQUENCY" || command == "RANGE")
+    {
+        return answer_statistic(command, ssRequest);
+    }
+    else if(command == "PHASE")
+    {
+        return answer_phase(ssRequest);
+    }
+    else if(command == "CYCLE")
+    {
+        return answer_cycle(ssRequest);
+    }
+    else if(command == "SHUTDOWN")
+    {
+        stopping = true;
+        ssResponse << "OK";
+    }
+    else
+    {
+        return "ERR unknown request: " + command;
+    }
+
+    return ssResponse.str();
+}
+
+
+// string answer_statistic(const string&, istringstream&) const method
+
+/// This method answers an AMPLITUDE, OFFSET, FREQUENCY or RANGE request: "<command> id [t0 t1] [CREST|TROUGH]".
+/// @param command Request command.
+/// @param ssRequest Request, positioned after the command.
+
+string Analysis_Daemon::answer_statistic(const string& command, istringstream& ssRequest) const
+{
+    const int i = parse_signal(ssRequest);
+    double t0;
+    double t1;
+    string basis;
+
+    if(i < 0)
+    {
+        return "ERR unknown signal";
+    }
+    if(!parse_window(ssRequest, t0, t1, basis))
+    {
+        return "ERR bad time window or basis";
+    }
+
+    ostringstream ssResponse;
+    ssResponse << setprecision(10) << "OK";
+
+    if(command == "FREQUENCY")
+    {
+        const double frequency = index.estimate_frequency(i, basis == "CREST" ? CREST_BASIS : TROUGH_BASIS, t0, t1);
+        if(std::isnan(frequency))
+        {
+            return "ERR less than two extrema in window";
+        }
+        ssResponse << " " << frequency;
+    }
+    else
+    {
+        const double amplitude = index.estimate_amplitude(i, t0, t1);
+        const double offset = index.estimate_offset(i, t0, t1);
+
+        if(std::isnan(amplitude))
+        {
+            return "ERR no crest or trough in window";
+        }
+
+        if(command == "AMPLITUDE")
+        {
+            ssResponse << " " << amplitude;
+        }
+        else if(command == "OFFSET")
+        {
+            ssResponse << " " << offset;
+        }
+        else
+        {
+            ssResponse << " " << amplitude + offset << " " << -amplitude + offset;
+        }
+    }
+
+    return ssResponse.str();
+}
+
+
+// string answer_phase(istringstream&) const method
+
+/// This method answers a PHASE request: "PHASE id_1 id_2 [t0 t1] [CREST|TROUGH]".
+/// @param ssRequest Request, positioned after the command.
+
+string Analysis_Daemon::answer_phase(istringstream& ssRequest) const
+{
+    const int i = parse_signal(ssRequest);
+    const int j = parse_signal(ssRequest);
+    double t0;
+    double t1;
+    string basis;
+    unsigned int count;
+
+    if(i < 0 || j < 0 || i == j)
+    {
+        return "ERR unknown or identical signals";
+    }
+    if(!parse_window(ssRequest, t0, t1, basis))
+    {
+        return "ERR bad time window or basis";
+    }
+
+    const double avg_phase = index.estimate_phase(i, j, basis == "CREST" ? CREST_BASIS : TROUGH_BASIS, t0, t1, count);
+    if(count == 0)
+    {
+        return "ERR no phase samples in window";
+    }
+
+    ostringstream ssResponse;
+    ssResponse << setprecision(10) << "OK " << avg_phase << " " << count;
+
+    return ssResponse.str();
+}
+
+
+// string answer_cycle(istringstream&) const method
+
+/// This method answers a CYCLE request: "CYCLE id t".
+/// @param ssRequest Request, positioned after the command.
+
+string Analysis_Daemon::answer_cycle(istringstream& ssRequest) const
+{
+    const int i = parse_signal(ssRequest);
+    double t;
+
+    if(i < 0 || !(ssRequest >> t))
+    {
+        return "ERR usage: CYCLE id t";
+    }
+
+    const vector<Cycle>& series = cycles[i].get_cycles();
+    if(series.empty())
+    {
+        return "ERR no cycles";
+    }
+
+    //--First cycle at or after t, or the one before it if that is closer--//
+    unsigned int begin = 0;
+    unsigned int end = series.size();
+    while(begin < end)
+    {
+        const unsigned int middle = (begin + end)/2;
+        if(series[middle].time < t)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    if(begin == series.size() || (begin > 0 && t - series[begin-1].time < series[begin].time - t))
+    {
+        begin--;
+    }
+
+    ostringstream ssResponse;
+    ssResponse << setprecision(10) << "OK " << series[begin].time << " " << series[begin].amplitude
+               << " " << series[begin].offset << " " << series[begin].frequency;
+
+    return ssResponse.str();
+}
+
+
+// int parse_signal(istringstream&) const method
+
+/// This method reads a signal ID from a request and returns the position of the signal on the list, or -1.
+/// @param ssRequest Request, positioned before the signal ID.
+
+int Analysis_Daemon::parse_signal(istringstream& ssRequest) const
+{
+    unsigned int signal_id;
+
+    if(!(ssRequest >> signal_id))
+    {
+        return -1;
+    }
+
+    return sList.find_signal(signal_id);
+}
+
+
+// bool parse_window(istringstream&, double&, double&, string&) const method
+
+/// This method reads the optional time window and basis, "[t0 t1] [CREST|TROUGH]", at the end of a request.
+/// Returns false if they are malformed, or if the window is not finite or ends before it starts.
+/// @param ssRequest Request, positioned before the optional time window.
+/// @param t0 Start time of the window. The start of the recording if absent.
+/// @param t1 End time of the window. The end of the recording if absent.
+/// @param basis CREST or TROUGH. TROUGH if absent.
+
+bool Analysis_Daemon::parse_window(istringstream& ssRequest, double& t0, double& t1, string& basis) const
+{
+    string token;
+
+    t0 = -HUGE_VAL;
+    t1 = HUGE_VAL;
+    basis = "TROUGH";
+
+    if(ssRequest >> token)
+    {
+        if(token == "CREST" || token == "TROUGH")
+        {
+            basis = token;
+        }
+        else
+        {
+            char* end;
+
+            t0 = strtod(token.c_str(), &end);
+            if(*end != '\0' || !(ssRequest >> t1))
+            {
+                return false;
+            }
+
+            //--strtod accepts "nan" and "inf"--//
+            if(!isfinite(t0) || !isfinite(t1) || t0 > t1)
+            {
+                return false;
+            }
+            if(ssRequest >> token)
+            {
+                basis = token;
+            }
+        }
+    }
+
+    return (basis == "CREST" || basis == "TROUGH") && !(ssRequest >> token);
+}
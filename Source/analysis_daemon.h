@@ -0,0 +1,73 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   A N A L Y S I S   D A E M O N   C L A S S   H E A D E R                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef ANALYSIS_DAEMON_H
+#define ANALYSIS_DAEMON_H
+
+#include <atomic>
+#include <iomanip>
+
+#include "window_index.h"
+
+#define DAEMON_BACKLOG 64
+#define DAEMON_MAX_REQUEST 4096
+
+//--Connection of a client, polled by the daemon thread. While a batch of its requests is being answered on the
+//  pool, it is not polled, so that its responses are sent in the order of its requests--//
+struct Daemon_Client
+{
+    Daemon_Client(const int client_fd = -1) : fd(client_fd), busy(false) {}
+
+    int fd;
+    string pending;     // Received bytes not yet ending a line
+    bool busy;
+};
+
+class Analysis_Daemon
+{
+public:
+    Analysis_Daemon(const Signal_Analyzer_List&, const char* const, const unsigned int = 0);
+    ~Analysis_Daemon();
+
+    void run(void);
+    string answer(const string&);
+
+private:
+    void read_requests(Daemon_Client&);
+    void serve_requests(const int, const vector<string>&);
+    void finish_requests(vector<Daemon_Client>&);
+
+    string answer_statistic(const string&, istringstream&) const;
+    string answer_phase(istringstream&) const;
+    string answer_cycle(istringstream&) const;
+    int parse_signal(istringstream&) const;
+    bool parse_window(istringstream&, double&, double&, string&) const;
+
+    const Signal_Analyzer_List& sList;
+    string socket_path;
+
+    Thread_Pool pool;
+    int listen_fd;
+    atomic<bool> stopping;
+
+    //--Pipe on which the pool reports every answered batch of requests, waking the daemon thread--//
+    int wake_fd[2];
+
+    //--Derived series, kept resident between requests--//
+    Window_Index index;
+    vector<Cycle_Series> cycles;
+};
+
+#endif // ANALYSIS_DAEMON_H
@@ -0,0 +1,321 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   A N A L Y S I S   P L A N   C L A S S                                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "analysis_plan.h"
+
+//--Command line names of the outputs, in the order of Analysis_Output--//
+static const char* const output_names[NO_OF_OUTPUTS] = {"amplitude", "offset", "range", "phase", "phase-series", "frequency", "cycles", "extrema"};
+
+//--Names of the phase bases, in the order of Phase_Basis--//
+static const char* const basis_names[] = {"crest", "trough", "crossing"};
+
+
+// CONSTRUCTOR
+
+/// Creates the default plan: every output, crest and trough based phase differences, a trough based phase series,
+/// and the crop window [CROP_START:CROP_END].
+
+Analysis_Plan::Analysis_Plan(void)
+{
+    outputs.assign(NO_OF_OUTPUTS, true);
+
+    phase_basis.assign(CROSSING_BASIS+1, false);
+    phase_basis[CREST_BASIS] = true;
+    phase_basis[TROUGH_BASIS] = true;
+    series_basis = TROUGH_BASIS;
+
+    crop_start = CROP_START;
+    crop_end = CROP_END;
+
+    default_plan = true;
+}
+
+
+// void set_outputs(const string&) method
+
+/// This method restricts the run to the given outputs.
+/// @param list Comma separated output names: amplitude, offset, range, phase, phase-series, frequency, cycles, extrema.
+
+void Analysis_Plan::set_outputs(const string& list)
+{
+    stringstream ssNames(list);
+    string name;
+
+    outputs.assign(NO_OF_OUTPUTS, false);
+
+    while(getline(ssNames, name, ','))
+    {
+        unsigned int o = 0;
+        while(o < NO_OF_OUTPUTS && name != output_names[o])
+        {
+            o++;
+        }
+
+        if(o == NO_OF_OUTPUTS)
+        {
+            cerr << "SignalAnalyzer Error: AnalysisPlan class." << endl
+                 << "void set_outputs(const string&) method" << endl
+                 << "Unknown output: " << name << endl
+                 << "Outputs: amplitude, offset, range, phase, phase-series, frequency, cycles, extrema" << endl;
+
+            exit(1);
+        }
+
+        outputs[o] = true;
+    }
+
+    default_plan = false;
+}
+
+
+// void set_basis(const string&) method
+
+/// This method sets the signal feature the phase differences are measured on. With both, the phase series is trough based.
+/// The crossing basis also sets the basis of the frequency, which is otherwise trough based.
+/// @param basis crest, trough, both or crossing.
+
+void Analysis_Plan::set_basis(const string& basis)
+{
+    phase_basis.assign(CROSSING_BASIS+1, false);
+
+    if(basis == "crest")
+    {
+        phase_basis[CREST_BASIS] = true;
+        series_basis = CREST_BASIS;
+    }
+    else if(basis == "trough" || basis == "both")
+    {
+        phase_basis[CREST_BASIS] = (basis == "both");
+        phase_basis[TROUGH_BASIS] = true;
+        series_basis = TROUGH_BASIS;
+    }
+    else if(basis == "crossing")
+    {
+        phase_basis[CROSSING_BASIS] = true;
+        series_basis = CROSSING_BASIS;
+    }
+    else
+    {
+        cerr << "SignalAnalyzer Error: AnalysisPlan class." << endl
+             << "void set_basis(const string&) method" << endl
+             << "Unknown phase basis: " << basis << ", expected crest, trough, both or crossing" << endl;
+
+        exit(1);
+    }
+
+    default_plan = false;
+}
+
+
+// void set_crop(const double, const double) method
+
+/// This method sets the time window the crests and troughs are cropped to, before any estimate.
+/// @param start Time below which crests and troughs are removed.
+/// @param end Time above which crests and troughs are removed.
+
+void Analysis_Plan::set_crop(const double start, const double end)
+{
+    if(start >= end)
+    {
+        cerr << "SignalAnalyzer Error: AnalysisPlan class." << endl
+             << "void set_crop(const double, const double) method" << endl
+             << "Empty crop window: [" << start << ":" << end << "]" << endl;
+
+        exit(1);
+    }
+
+    crop_start = start;
+    crop_end = end;
+
+    default_plan = false;
+}
+
+
+// bool has_output(const Analysis_Output) const method
+
+/// This method returns true if the output was requested.
+/// @param output Output.
+
+bool Analysis_Plan::has_output(const Analysis_Output output) const
+{
+    return outputs[output];
+}
+
+
+// bool needs_filter(void) const method
+
+/// This method returns true if any requested output needs the crests and troughs filtered across signals.
+/// Filtered extrema files are written by the filter itself.
+
+bool Analysis_Plan::needs_filter(void) const
+{
+    for(unsigned int o=0; o<NO_OF_OUTPUTS; o++)
+    {
+        if(outputs[o])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// bool needs_crop(void) const method
+
+/// This method returns true if any estimate was requested, as every estimate is made within the crop window.
+
+bool Analysis_Plan::needs_crop(void) const
+{
+    for(unsigned int o=0; o<NO_OF_OUTPUTS; o++)
+    {
+        if(outputs[o] && o != EXTREMA_OUTPUT)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// bool needs_phase(const Phase_Basis) const method
+
+/// This method returns true if the phase difference of every pair of signals is needed on the given basis,
+/// for the average phase differences or for the phase series.
+/// @param basis Crest, trough or crossing basis.
+
+bool Analysis_Plan::needs_phase(const Phase_Basis basis) const
+{
+    return shows_phase(basis) || saves_phase_series(basis);
+}
+
+
+// bool shows_phase(const Phase_Basis) const method
+
+/// This method returns true if the average phase differences are shown on the given basis.
+/// @param basis Crest, trough or crossing basis.
+
+bool Analysis_Plan::shows_phase(const Phase_Basis basis) const
+{
+    return outputs[PHASE_OUTPUT] && phase_basis[basis];
+}
+
+
+// bool saves_phase_series(const Phase_Basis) const method
+
+/// This method returns true if the phase series is saved on the given basis.
+/// @param basis Crest, trough or crossing basis.
+
+bool Analysis_Plan::saves_phase_series(const Phase_Basis basis) const
+{
+    return outputs[PHASE_SERIES_OUTPUT] && series_basis == basis;
+}
+
+
+// bool needs_crossings(void) const method
+
+/// This method returns true if the crossings of the signal mean must be found during ingest, for the phase or the frequency.
+
+bool Analysis_Plan::needs_crossings(void) const
+{
+    return needs_phase(CROSSING_BASIS) || (outputs[FREQUENCY_OUTPUT] && get_frequency_basis() == CROSSING_BASIS);
+}
+
+
+// bool writes_files(void) const method
+
+/// This method returns true if any requested output is written to file rather than displayed.
+
+bool Analysis_Plan::writes_files(void) const
+{
+    return outputs[PHASE_SERIES_OUTPUT] || outputs[CYCLES_OUTPUT] || outputs[EXTREMA_OUTPUT];
+}
+
+
+// Phase_Basis get_frequency_basis(void) const method
+
+/// This method returns the signal feature the frequency is estimated on: crossings with the crossing basis, troughs otherwise.
+
+Phase_Basis Analysis_Plan::get_frequency_basis(void) const
+{
+    return phase_basis[CROSSING_BASIS] ? CROSSING_BASIS : TROUGH_BASIS;
+}
+
+
+// double get_crop_start(void) const method
+
+/// This method returns the start of the crop window.
+
+double Analysis_Plan::get_crop_start(void) const
+{
+    return crop_start;
+}
+
+
+// double get_crop_end(void) const method
+
+/// This method returns the end of the crop window.
+
+double Analysis_Plan::get_crop_end(void) const
+{
+    return crop_end;
+}
+
+
+// bool is_default(void) const method
+
+/// This method returns true if no output, basis or crop window was set on the command line.
+
+bool Analysis_Plan::is_default(void) const
+{
+    return default_plan;
+}
+
+
+// void show_plan(void) const method
+
+/// This method displays the stages the run goes through, and the outputs it produces.
+
+void Analysis_Plan::show_plan(void) const
+{
+    cout << endl << "Plan: ingest";
+
+    if(needs_filter())
+    {
+        cout << ", filter";
+    }
+    if(needs_crop())
+    {
+        cout << ", crop [" << crop_start << ":" << crop_end << "]";
+    }
+    for(unsigned int b=CREST_BASIS; b<=CROSSING_BASIS; b++)
+    {
+        if(needs_phase((Phase_Basis)b))
+        {
+            cout << ", " << basis_names[b] << " based pair phases";
+        }
+    }
+
+    cout << endl << "Outputs:";
+    for(unsigned int o=0; o<NO_OF_OUTPUTS; o++)
+    {
+        if(outputs[o])
+        {
+            cout << " " << output_names[o];
+        }
+    }
+    cout << endl;
+}
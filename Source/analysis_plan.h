@@ -0,0 +1,88 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   A N A L Y S I S   P L A N   C L A S S   H E A D E R                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef ANALYSIS_PLAN_H
+#define ANALYSIS_PLAN_H
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+
+#include "signal_analyzer.h"
+
+using namespace std;
+
+//--Results a run can produce--//
+enum Analysis_Output
+{
+    AMPLITUDE_OUTPUT,
+    OFFSET_OUTPUT,
+    RANGE_OUTPUT,
+    PHASE_OUTPUT,           // Average phase difference of every pair of signals
+    PHASE_SERIES_OUTPUT,    // 'phase180' and 'phase360' files
+    FREQUENCY_OUTPUT,
+    CYCLES_OUTPUT,          // 'S<id>_cycles' files
+    EXTREMA_OUTPUT,         // 'S<id>_crest', 'S<id>_trough' and their filtered files
+    NO_OF_OUTPUTS
+};
+
+#define CROP_START 1.0
+#define CROP_END 119.0
+
+/// Stages of a run, derived from the outputs requested on the command line.
+/// Every estimate needs the crests and troughs filtered and cropped. The phase difference of every pair of
+/// signals is calculated once per basis, and shared by the averages and the phase series that need it.
+
+class Analysis_Plan
+{
+public:
+    Analysis_Plan(void);
+
+    void set_outputs(const string&);
+    void set_basis(const string&);
+    void set_crop(const double, const double);
+
+    bool has_output(const Analysis_Output) const;
+    bool needs_filter(void) const;
+    bool needs_crop(void) const;
+    bool needs_phase(const Phase_Basis) const;
+    bool shows_phase(const Phase_Basis) const;
+    bool saves_phase_series(const Phase_Basis) const;
+    bool needs_crossings(void) const;
+    bool writes_files(void) const;
+    Phase_Basis get_frequency_basis(void) const;
+
+    double get_crop_start(void) const;
+    double get_crop_end(void) const;
+
+    bool is_default(void) const;
+    void show_plan(void) const;
+
+private:
+    vector<bool> outputs;
+
+    //--Bases of the average phase differences, and of the phase series--//
+    vector<bool> phase_basis;
+    Phase_Basis series_basis;
+
+    double crop_start;
+    double crop_end;
+
+    bool default_plan;
+};
+
+#endif // ANALYSIS_PLAN_H
@@ -0,0 +1,138 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   C O L U M N   P A R S E R   C L A S S                                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "column_parser.h"
+
+// CONSTRUCTOR
+
+/// Creates a Column Parser object for the given signals of a data file.
+/// Column 0 of the file is time, and column k holds the signal with ID k.
+/// Only the time and the selected columns are converted to numbers. The other fields are skipped over.
+/// @param signalIDList A vector containing the IDs of the signals to be extracted, in the order they are returned.
+
+Column_Parser::Column_Parser(const vector<unsigned int>& signalIDList)
+{
+    no_of_signals = signalIDList.size();
+
+    //--Pairs of (column, position on the signal ID list), sorted to visit the columns in file order--//
+    vector<pair<unsigned int, unsigned int> > selected;
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        if(signalIDList[i] == 0)
+        {
+            cerr << "SignalAnalyzer Error: ColumnParser class." << endl
+                 << "Column_Parser(const vector<unsigned int>&) method" << endl
+                 << "Signal IDs start at 1, column 0 is time" << endl;
+
+            exit(1);
+        }
+
+        selected.push_back(make_pair(signalIDList[i], i));
+    }
+    sort(selected.begin(), selected.end());
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        columns.push_back(selected[i].first);
+        positions.push_back(selected[i].second);
+    }
+}
+
+
+// bool parse_line(const string&, double&, vector<double>&) const method
+
+/// This method parses one line of the data file in a single pass.
+/// Returns false, leaving the parameters untouched, for lines containing '#' and empty lines.
+/// @param line Line of the data file.
+/// @param time Time value of the line.
+/// @param values Values of the selected signals, in the order of the signal ID list.
+
+bool Column_Parser::parse_line(const string& line, double& time, vector<double>& values) const
+{
+    //--Omitting lines containing '#'--//
+    if(line.find('#') != string::npos)
+    {
+        return false;
+    }
+
+    const char* cursor = line.c_str();
+    char* end;
+
+    time = strtod(cursor, &end);
+    if(end == cursor)
+    {
+        //--Empty line--//
+        return false;
+    }
+    cursor = end;
+
+    values.resize(no_of_signals);
+
+    unsigned int column = 0;
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        //--Skip the fields between the previous and the next selected column without converting them--//
+        while(column+1 < columns[i])
+        {
+            while(*cursor == ' ' || *cursor == '\t')
+            {
+                cursor++;
+            }
+            if(*cursor == '\0' || *cursor == '\r' || *cursor == '\n')
+            {
+                break;
+            }
+            while(*cursor != '\0' && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n')
+            {
+                cursor++;
+            }
+            column++;
+        }
+
+        //--Repeated signal IDs share the column--//
+        if(column == columns[i])
+        {
+            values[positions[i]] = values[positions[i-1]];
+            continue;
+        }
+
+        const double value = strtod(cursor, &end);
+        if(end == cursor)
+        {
+            cerr << "SignalAnalyzer Error: ColumnParser class." << endl
+                 << "bool parse_line(const string&, double&, vector<double>&) const method" << endl
+                 << "Signal_" << columns[i] << " not found on line: " << line << endl;
+
+            exit(1);
+        }
+
+        values[positions[i]] = value;
+        cursor = end;
+        column = columns[i];
+    }
+
+    return true;
+}
+
+
+// unsigned int get_no_of_signals(void) const method
+
+/// This method returns the number of selected signals.
+
+unsigned int Column_Parser::get_no_of_signals(void) const
+{
+    return no_of_signals;
+}
@@ -0,0 +1,44 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   C O L U M N   P A R S E R   C L A S S   H E A D E R                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef COLUMN_PARSER_H
+#define COLUMN_PARSER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace std;
+
+class Column_Parser
+{
+public:
+    Column_Parser(const vector<unsigned int>&);
+
+    bool parse_line(const string&, double&, vector<double>&) const;
+
+    unsigned int get_no_of_signals(void) const;
+
+private:
+    //--Selected columns in file order, and the position of each on the signal ID list--//
+    vector<unsigned int> columns;
+    vector<unsigned int> positions;
+
+    unsigned int no_of_signals;
+};
+
+#endif // COLUMN_PARSER_H
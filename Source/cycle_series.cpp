@@ -0,0 +1,118 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   C Y C L E   S E R I E S   C L A S S                                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "cycle_series.h"
+
+// CONSTRUCTOR
+
+/// Creates an empty Cycle Series object.
+/// Crests and troughs are added in time order. Every crest that follows a crest and a trough closes a
+/// crest-trough-crest cycle, whose amplitude, offset and frequency are appended to the series in O(1).
+
+Cycle_Series::Cycle_Series(void)
+{
+    clear();
+}
+
+
+// void add_crest(const double, const double) method
+
+/// This method adds the next crest of the signal. If a crest and a trough precede it, a cycle is completed.
+/// @param time Time of the crest.
+/// @param value Value of the crest.
+
+void Cycle_Series::add_crest(const double time, const double value)
+{
+    if(has_crest && has_trough && time > crest_time)
+    {
+        Cycle cycle;
+        const double crest_avg = (crest_value + value)/2.0;
+
+        cycle.time = trough_time;
+        cycle.offset = (crest_avg + trough_value)/2.0;
+        cycle.amplitude = crest_avg - cycle.offset;
+        cycle.frequency = 1.0/(time - crest_time);
+
+        cycles.push_back(cycle);
+    }
+
+    //--The crest closing a cycle opens the next one--//
+    has_crest = true;
+    crest_time = time;
+    crest_value = value;
+
+    has_trough = false;
+}
+
+
+// void add_trough(const double, const double) method
+
+/// This method adds the next trough of the signal. Troughs before the first crest are ignored.
+/// If several troughs fall between two crests, the lowest one is used.
+/// @param time Time of the trough.
+/// @param value Value of the trough.
+
+void Cycle_Series::add_trough(const double time, const double value)
+{
+    if(!has_crest)
+    {
+        return;
+    }
+
+    if(!has_trough || value < trough_value)
+    {
+        has_trough = true;
+        trough_time = time;
+        trough_value = value;
+    }
+}
+
+
+// void clear(void) method
+
+/// This method removes all cycles from the series.
+
+void Cycle_Series::clear(void)
+{
+    has_crest = false;
+    has_trough = false;
+
+    crest_time = 0.0;
+    crest_value = 0.0;
+    trough_time = 0.0;
+    trough_value = 0.0;
+
+    cycles.clear();
+}
+
+
+// const vector<Cycle>& get_cycles(void) const method
+
+/// This method returns the completed cycles, in time order.
+
+const vector<Cycle>& Cycle_Series::get_cycles(void) const
+{
+    return cycles;
+}
+
+
+// unsigned int size(void) const method
+
+/// This method returns the number of completed cycles.
+
+unsigned int Cycle_Series::size(void) const
+{
+    return cycles.size();
+}
@@ -0,0 +1,56 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   C Y C L E   S E R I E S   C L A S S   H E A D E R                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef CYCLE_SERIES_H
+#define CYCLE_SERIES_H
+
+#include <vector>
+
+using namespace std;
+
+//--Parameters of one crest-trough-crest cycle of a signal--//
+struct Cycle
+{
+    double time;        // Time of the trough of the cycle.
+    double amplitude;   // ((crest_1 + crest_2)/2 - trough)/2
+    double offset;      // ((crest_1 + crest_2)/2 + trough)/2
+    double frequency;   // 1.0/(time of crest_2 - time of crest_1)
+};
+
+class Cycle_Series
+{
+public:
+    Cycle_Series(void);
+
+    void add_crest(const double, const double);
+    void add_trough(const double, const double);
+    void clear(void);
+
+    const vector<Cycle>& get_cycles(void) const;
+    unsigned int size(void) const;
+
+private:
+    bool has_crest;
+    double crest_time;
+    double crest_value;
+
+    bool has_trough;
+    double trough_time;
+    double trough_value;
+
+    vector<Cycle> cycles;
+};
+
+#endif // CYCLE_SERIES_H
@@ -1,37 +1,388 @@
 #include "signal_analyzer_list.h"
+#include "analysis_daemon.h"
+#include "sinusoid_fit.h"
+#include "analysis_plan.h"
+#include "result_cache.h"
 
 
 int main(int argc, char* argv[])
 {
-    char* fileName;
+    char* fileName = NULL;
+    Ingest_Options options;
+    Phase_Mode phaseMode = ALL_PAIRS_PHASE;
+    Filter_Mode filterMode = PAIRWISE_FILTER;
+    Output_Format format = TEXT_OUTPUT;
+    char* socketPath = NULL;
+    bool envelope = false;
+    double envelopeStart = 0.0;
+    double envelopeEnd = 0.0;
+    unsigned int envelopeWidth = 0;
+    vector<unsigned int> signalIDs;
+    bool fit = false;
+    double fitFrequency = 0.0;
+    char* traceFile = NULL;
+    bool pushdown = false;
+    char* cacheDirectory = NULL;
+    Analysis_Plan plan;
 
-    if(argc == 1)
+    for(int i=1; i<argc; i++)
     {
-        fileName = NULL;
+        string arg(argv[i]);
+
+        if(arg == "--pipelined")
+        {
+            options.mode = PIPELINED_INGEST;
+        }
+        else if(arg == "--phase-reference")
+        {
+            phaseMode = REFERENCE_PHASE;
+        }
+        else if(arg == "--consensus-filter")
+        {
+            filterMode = CONSENSUS_FILTER;
+        }
+        else if(arg == "--coarse-detect")
+        {
+            options.detection = COARSE_DETECTION;
+        }
+        else if(arg == "--binary")
+        {
+            format = BINARY_OUTPUT;
+        }
+        else if(arg == "--daemon" && i+1 < argc)
+        {
+            socketPath = argv[++i];
+        }
+        else if(arg == "--envelope" && i+3 < argc)
+        {
+            envelope = true;
+            envelopeStart = atof(argv[++i]);
+            envelopeEnd = atof(argv[++i]);
+            envelopeWidth = atoi(argv[++i]);
+        }
+        else if(arg == "--signals" && i+1 < argc)
+        {
+            //--Comma separated list of signal IDs--//
+            stringstream ssIDs(argv[++i]);
+            string id;
+
+            while(getline(ssIDs, id, ','))
+            {
+                signalIDs.push_back(atoi(id.c_str()));
+            }
+        }
+        else if(arg == "--incremental" && i+1 < argc)
+        {
+            options.checkpoint = argv[++i];
+        }
+        else if(arg == "--outputs" && i+1 < argc)
+        {
+            plan.set_outputs(argv[++i]);
+        }
+        else if(arg == "--basis" && i+1 < argc)
+        {
+            plan.set_basis(argv[++i]);
+        }
+        else if(arg == "--crop" && i+2 < argc)
+        {
+            const double cropStart = atof(argv[++i]);
+            plan.set_crop(cropStart, atof(argv[++i]));
+        }
+        else if(arg == "--pushdown")
+        {
+            pushdown = true;
+        }
+        else if(arg == "--cache" && i+1 < argc)
+        {
+            cacheDirectory = argv[++i];
+        }
+        else if(arg == "--trace" && i+1 < argc)
+        {
+            traceFile = argv[++i];
+        }
+        else if(arg == "--fit")
+        {
+            fit = true;
+        }
+        else if(arg == "--fit-frequency" && i+1 < argc)
+        {
+            fit = true;
+            fitFrequency = atof(argv[++i]);
+        }
+        else if(arg == "--median" && i+1 < argc)
+        {
+            options.prefilter = Prefilter_Options(MEDIAN_PREFILTER, atoi(argv[++i]));
+        }
+        else if(arg == "--hampel" && i+2 < argc)
+        {
+            const unsigned int window = atoi(argv[++i]);
+            options.prefilter = Prefilter_Options(HAMPEL_PREFILTER, window, atof(argv[++i]));
+        }
+        else if(arg == "--memory-budget" && i+1 < argc)
+        {
+            //--Megabytes--//
+            options.memory_budget = strtoul(argv[++i], NULL, 10) * 1024 * 1024;
+        }
+        else if(arg.compare(0, 2, "--") != 0 && fileName == NULL)
+        {
+            fileName = argv[i];
+        }
+        else
+        {
+            cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+                 << "main(int, char*) method" << endl
+                 << "Unknown or repeated command line parameter: "<< arg << endl
+                 << "Usage: SignalAnalyzer [--pipelined] [--phase-reference] [--consensus-filter] [--coarse-detect] [--binary] [--daemon socket] [--envelope t0 t1 width] [--signals id,id,...] [--memory-budget MB] [--median window] [--hampel window threshold] [--incremental checkpoint] [--fit] [--fit-frequency Hz] [--trace file] [--outputs name,name,...] [--basis crest|trough|both|crossing] [--crop t0 t1] [--pushdown] [--cache directory] [signals file]" << endl;
+
+            exit(1);
+        }
     }
-    else if(argc == 2)
+
+    if(envelope && (options.memory_budget > 0 || options.checkpoint))
     {
-        fileName = argv[1];
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "main(int, char*) method" << endl
+             << "--envelope needs the signal data, which --memory-budget and --incremental release" << endl;
+
+        exit(1);
     }
-    else
+
+    if(pushdown && options.checkpoint)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "main(int, char*) method" << endl
+             << "--pushdown reads only the crop window, which --incremental cannot resume from" << endl;
+
+        exit(1);
+    }
+
+    if(plan.needs_crossings() && options.checkpoint)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "main(int, char*) method" << endl
+             << "--basis crossing needs every sample, which --incremental does not keep" << endl;
+
+        exit(1);
+    }
+
+    if(cacheDirectory && (envelope || options.checkpoint || fit))
     {
         cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
              << "main(int, char*) method" << endl
-             << "Too many or too few command line parameters: "<< argc << endl;
+             << "--cache holds only crests, troughs and estimates, not the signal data that --envelope, --incremental and --fit need" << endl;
 
         exit(1);
     }
 
-    Signal_Analyzer_List sList(fileName);
-    sList.filter_signal();
-    sList.crop_signal_length(1.0, 119.0);
-    sList.show_signal_amplitudes();
-    sList.show_signal_offsets();
-    sList.show_signal_range();
-    sList.calculate_phaseVector_trough();
-    sList.show_phase_relation_crest();
-    sList.show_phase_relation_trough();
-    sList.show_signal_frequency();
+    if(traceFile)
+    {
+        Trace_Recorder::start();
+    }
+
+    options.extrema_output = plan.has_output(EXTREMA_OUTPUT);
+    options.crossings = plan.needs_crossings();
+
+    //--Rows outside the crop window are not even parsed--//
+    options.read_window = pushdown;
+    options.window_start = plan.get_crop_start();
+    options.window_end = plan.get_crop_end();
+
+    //--Allocations per stage, counted only in builds with TRACK_ALLOCATIONS--//
+    Allocation_Tracker tracker;
+
+    if(fit)
+    {
+        //--Least-squares engine instead of the crest and trough pipeline--//
+        tracker.begin_stage("Fit");
+        Sinusoid_Fit sFit = signalIDs.empty() ? Sinusoid_Fit(fileName) : Sinusoid_Fit(fileName, signalIDs);
+        sFit.fit(plan.get_crop_start(), plan.get_crop_end(), fitFrequency);
+        tracker.end_stage();
+
+        sFit.show_signal_amplitudes();
+        sFit.show_signal_offsets();
+        sFit.show_phase_relation();
+        sFit.show_signal_frequency();
+        sFit.show_fit_residuals();
+
+        tracker.show_stages();
+
+        if(traceFile)
+        {
+            cout << endl << "Trace: " << Trace_Recorder::save(traceFile) << " spans saved to " << traceFile << endl;
+        }
+
+        return 0;
+    }
+
+    if(!plan.is_default())
+    {
+        plan.show_plan();
+    }
+
+    //--Intermediates and results of earlier runs on the same data and parameters--//
+    Result_Cache cache(cacheDirectory, fileName);
+    cache.set_ingest_key(signalIDs, options);
+    cache.set_filter_key(filterMode, plan);
+    cache.set_results_key(phaseMode, plan);
+
+    //--Results are kept only if they are all displayed, and filtered extrema only if they are not saved to file--//
+    const bool cache_results = !socketPath && plan.needs_filter() && !plan.writes_files();
+    const bool cache_filtered = (plan.needs_crop() || socketPath) && !plan.has_output(EXTREMA_OUTPUT);
+
+    string cached_results;
+    if(cache_results && cache.read_entry(RESULTS_STAGE, cached_results))
+    {
+        Signal_Analyzer_List::remove_output_files();
+
+        cout << endl << "Cache: results from " << cache.get_path(RESULTS_STAGE) << endl << cached_results;
+
+        if(traceFile)
+        {
+            cout << endl << "Trace: " << Trace_Recorder::save(traceFile) << " spans saved to " << traceFile << endl;
+        }
+
+        return 0;
+    }
+
+    string cached_state;
+    const bool filtered_hit = cache_filtered && cache.read_entry(FILTERED_STAGE, cached_state);
+    const bool detected_hit = !filtered_hit && cache.read_entry(DETECTED_STAGE, cached_state);
+    istringstream state(cached_state);
+
+    tracker.begin_stage("Ingest");
+    Signal_Analyzer_List sList = filtered_hit || detected_hit ? Signal_Analyzer_List(state, options, format)
+                               : signalIDs.empty() ? Signal_Analyzer_List(fileName, options, format)
+                                                   : Signal_Analyzer_List(fileName, signalIDs, options, format);
+    tracker.end_stage();
+
+    if(filtered_hit || detected_hit)
+    {
+        cout << endl << "Cache: " << (filtered_hit ? "filtered and cropped" : "detected") << " extrema from "
+             << cache.get_path(filtered_hit ? FILTERED_STAGE : DETECTED_STAGE) << endl;
+    }
+    else if(cache.is_enabled())
+    {
+        ostringstream detected_state;
+        detected_state.precision(17);
+
+        sList.save_extrema_state(detected_state);
+        cache.write_entry(DETECTED_STAGE, detected_state.str());
+    }
+
+    sList.set_phase_mode(phaseMode);
+    sList.set_filter_mode(filterMode);
+
+    if(envelope)
+    {
+        tracker.begin_stage("Envelope");
+        sList.save_signal_envelopes(envelopeStart, envelopeEnd, envelopeWidth);
+        tracker.end_stage();
+    }
+
+    //--The daemon answers queries on the filtered and cropped extrema--//
+    if((plan.needs_filter() || socketPath) && !filtered_hit)
+    {
+        tracker.begin_stage("Filter");
+        sList.filter_signal();
+        tracker.end_stage();
+    }
+
+    if((plan.needs_crop() || socketPath) && !filtered_hit)
+    {
+        tracker.begin_stage("Crop");
+        sList.crop_signal_length(plan.get_crop_start(), plan.get_crop_end());
+        tracker.end_stage();
+
+        if(cache_filtered && cache.is_enabled())
+        {
+            ostringstream filtered_state;
+            filtered_state.precision(17);
+
+            sList.save_extrema_state(filtered_state);
+            cache.write_entry(FILTERED_STAGE, filtered_state.str());
+        }
+    }
+
+    if(socketPath)
+    {
+        Analysis_Daemon daemon(sList, socketPath);
+        daemon.run();
+
+        return 0;
+    }
+
+    //--Displayed results are captured, to be saved in the cache--//
+    ostringstream results;
+    streambuf* const console = cache_results && cache.is_enabled() ? cout.rdbuf(results.rdbuf()) : NULL;
+
+    if(plan.has_output(AMPLITUDE_OUTPUT) || plan.has_output(OFFSET_OUTPUT) || plan.has_output(RANGE_OUTPUT))
+    {
+        tracker.begin_stage("Amplitude, offset and range");
+        if(plan.has_output(AMPLITUDE_OUTPUT))
+        {
+            sList.show_signal_amplitudes();
+        }
+        if(plan.has_output(OFFSET_OUTPUT))
+        {
+            sList.show_signal_offsets();
+        }
+        if(plan.has_output(RANGE_OUTPUT))
+        {
+            sList.show_signal_range();
+        }
+        tracker.end_stage();
+    }
+
+    //--The pair phases of a basis are calculated once, for both the averages and the series--//
+    if(plan.needs_phase(CREST_BASIS) || plan.needs_phase(TROUGH_BASIS) || plan.needs_phase(CROSSING_BASIS))
+    {
+        tracker.begin_stage("Phase");
+        if(plan.needs_phase(CREST_BASIS))
+        {
+            sList.calculate_phase_outputs(CREST_BASIS, plan.shows_phase(CREST_BASIS), plan.saves_phase_series(CREST_BASIS));
+        }
+        if(plan.needs_phase(TROUGH_BASIS))
+        {
+            sList.calculate_phase_outputs(TROUGH_BASIS, plan.shows_phase(TROUGH_BASIS), plan.saves_phase_series(TROUGH_BASIS));
+        }
+        if(plan.needs_phase(CROSSING_BASIS))
+        {
+            sList.calculate_phase_outputs(CROSSING_BASIS, plan.shows_phase(CROSSING_BASIS), plan.saves_phase_series(CROSSING_BASIS));
+        }
+        tracker.end_stage();
+    }
+
+    if(plan.has_output(FREQUENCY_OUTPUT))
+    {
+        tracker.begin_stage("Frequency");
+        sList.show_signal_frequency(plan.get_frequency_basis());
+        tracker.end_stage();
+    }
+
+    if(console)
+    {
+        cout.rdbuf(console);
+        cache.write_entry(RESULTS_STAGE, results.str());
+        cout << results.str();
+    }
+
+    if(plan.has_output(CYCLES_OUTPUT))
+    {
+        tracker.begin_stage("Cycle series");
+        sList.calculate_cycle_series();
+        tracker.end_stage();
+    }
+
+    if(Allocation_Tracker::is_enabled())
+    {
+        tracker.show_stages();
+        sList.show_memory_usage();
+    }
+
+    if(traceFile)
+    {
+        cout << endl << "Trace: " << Trace_Recorder::save(traceFile) << " spans saved to " << traceFile << endl;
+    }
 
     return 0;
 }
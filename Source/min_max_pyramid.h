@@ -0,0 +1,299 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   M I N   M A X   P Y R A M I D   C L A S S   H E A D E R                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef MIN_MAX_PYRAMID_H
+#define MIN_MAX_PYRAMID_H
+
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+//--Level 0 of the pyramid holds blocks of 2^PYRAMID_BASE_LEVEL samples--//
+#define PYRAMID_BASE_LEVEL 6
+
+/// Multi-resolution minimum and maximum of a signal. Level l holds the minimum and maximum of every complete,
+/// aligned block of 2^(PYRAMID_BASE_LEVEL + l) samples, and is built incrementally as samples are appended.
+/// The levels together take about 1/2^(PYRAMID_BASE_LEVEL - 1) of the memory of the samples.
+
+template <typename T>
+class Min_Max_Pyramid
+{
+public:
+    Min_Max_Pyramid(void);
+
+    void append(const T);
+    void clear(void);
+    void reserve(const unsigned int);
+
+    void range_min_max(const vector<T>&, unsigned int, unsigned int, T&, T&) const;
+
+    unsigned int get_no_samples(void) const;
+    unsigned int get_no_levels(void) const;
+    unsigned int get_block_size(const unsigned int) const;
+    const vector<T>& get_level_min(const unsigned int) const;
+    const vector<T>& get_level_max(const unsigned int) const;
+
+    unsigned long get_memory_usage(void) const;
+
+private:
+    unsigned int no_samples;
+
+    //--Minimum and maximum of the base block being filled--//
+    T block_min;
+    T block_max;
+
+    vector<vector<T> > level_min;
+    vector<vector<T> > level_max;
+};
+
+
+// CONSTRUCTOR
+
+/// Creates an empty pyramid.
+
+template <typename T>
+Min_Max_Pyramid<T>::Min_Max_Pyramid(void)
+{
+    clear();
+}
+
+
+// void append(const T) method
+
+/// Appends a sample to the end of the signal. Every completed block is added to its level, and merged
+/// with its left neighbour into the next level up.
+/// @param value Value of the sample.
+
+template <typename T>
+void Min_Max_Pyramid<T>::append(const T value)
+{
+    const unsigned int base_mask = (1u << PYRAMID_BASE_LEVEL) - 1;
+
+    if((no_samples & base_mask) == 0)
+    {
+        block_min = value;
+        block_max = value;
+    }
+    else
+    {
+        block_min = min(block_min, value);
+        block_max = max(block_max, value);
+    }
+    no_samples++;
+
+    if((no_samples & base_mask) != 0)
+    {
+        return;
+    }
+
+    T merged_min = block_min;
+    T merged_max = block_max;
+
+    for(unsigned int l=0; ; l++)
+    {
+        if(l == level_min.size())
+        {
+            level_min.push_back(vector<T>());
+            level_max.push_back(vector<T>());
+        }
+
+        level_min[l].push_back(merged_min);
+        level_max[l].push_back(merged_max);
+
+        const unsigned int size = level_min[l].size();
+        if(size % 2 != 0)
+        {
+            break;
+        }
+
+        merged_min = min(level_min[l][size-2], merged_min);
+        merged_max = max(level_max[l][size-2], merged_max);
+    }
+}
+
+
+// void clear(void) method
+
+/// Removes all samples from the pyramid.
+
+template <typename T>
+void Min_Max_Pyramid<T>::clear(void)
+{
+    no_samples = 0;
+    block_min = T();
+    block_max = T();
+
+    level_min.clear();
+    level_max.clear();
+}
+
+
+// void reserve(const unsigned int) method
+
+/// Allocates every level for a known number of samples, so that appending them does not reallocate.
+/// @param capacity Number of samples.
+
+template <typename T>
+void Min_Max_Pyramid<T>::reserve(const unsigned int capacity)
+{
+    for(unsigned int l=0; (capacity >> (PYRAMID_BASE_LEVEL + l)) > 0; l++)
+    {
+        if(l == level_min.size())
+        {
+            level_min.push_back(vector<T>());
+            level_max.push_back(vector<T>());
+        }
+
+        level_min[l].reserve(capacity >> (PYRAMID_BASE_LEVEL + l));
+        level_max[l].reserve(capacity >> (PYRAMID_BASE_LEVEL + l));
+    }
+}
+
+
+// void range_min_max(const vector<T>&, unsigned int, unsigned int, T&, T&) const method
+
+/// Calculates the minimum and maximum of the samples [begin,end), begin < end.
+/// The range is covered by the largest aligned blocks that fit, two per level at most, plus
+/// less than 2^PYRAMID_BASE_LEVEL samples read from the signal at each end.
+/// @param signal Samples the pyramid was built from.
+/// @param begin Index of the first sample of the range.
+/// @param end Index past the last sample of the range.
+/// @param range_min Minimum of the range.
+/// @param range_max Maximum of the range.
+
+template <typename T>
+void Min_Max_Pyramid<T>::range_min_max(const vector<T>& signal, unsigned int begin, unsigned int end, T& range_min, T& range_max) const
+{
+    const unsigned int base_mask = (1u << PYRAMID_BASE_LEVEL) - 1;
+
+    range_min = signal[begin];
+    range_max = signal[begin];
+
+    //--Unaligned samples at both ends--//
+    while(begin < end && (begin & base_mask) != 0)
+    {
+        range_min = min(range_min, signal[begin]);
+        range_max = max(range_max, signal[begin]);
+        begin++;
+    }
+    while(end > begin && (end & base_mask) != 0)
+    {
+        end--;
+        range_min = min(range_min, signal[end]);
+        range_max = max(range_max, signal[end]);
+    }
+
+    //--Aligned blocks, climbing one level while the ends are odd--//
+    begin >>= PYRAMID_BASE_LEVEL;
+    end >>= PYRAMID_BASE_LEVEL;
+
+    for(unsigned int l=0; begin < end; l++)
+    {
+        if(begin & 1)
+        {
+            range_min = min(range_min, level_min[l][begin]);
+            range_max = max(range_max, level_max[l][begin]);
+            begin++;
+        }
+        if(end & 1)
+        {
+            end--;
+            range_min = min(range_min, level_min[l][end]);
+            range_max = max(range_max, level_max[l][end]);
+        }
+
+        begin >>= 1;
+        end >>= 1;
+    }
+}
+
+
+// unsigned int get_no_samples(void) const method
+
+/// Returns the number of samples appended to the pyramid.
+
+template <typename T>
+unsigned int Min_Max_Pyramid<T>::get_no_samples(void) const
+{
+    return no_samples;
+}
+
+
+// unsigned int get_no_levels(void) const method
+
+/// Returns the number of levels of the pyramid.
+
+template <typename T>
+unsigned int Min_Max_Pyramid<T>::get_no_levels(void) const
+{
+    return level_min.size();
+}
+
+
+// unsigned int get_block_size(const unsigned int) const method
+
+/// Returns the number of samples per block on a level.
+/// @param level Level of the pyramid.
+
+template <typename T>
+unsigned int Min_Max_Pyramid<T>::get_block_size(const unsigned int level) const
+{
+    return 1u << (PYRAMID_BASE_LEVEL + level);
+}
+
+
+// const vector<T>& get_level_min(const unsigned int) const method
+
+/// Returns the block minima of a level.
+/// @param level Level of the pyramid.
+
+template <typename T>
+const vector<T>& Min_Max_Pyramid<T>::get_level_min(const unsigned int level) const
+{
+    return level_min[level];
+}
+
+
+// const vector<T>& get_level_max(const unsigned int) const method
+
+/// Returns the block maxima of a level.
+/// @param level Level of the pyramid.
+
+template <typename T>
+const vector<T>& Min_Max_Pyramid<T>::get_level_max(const unsigned int level) const
+{
+    return level_max[level];
+}
+
+
+// unsigned long get_memory_usage(void) const method
+
+/// Returns the bytes held by the block minima and maxima of all the levels.
+
+template <typename T>
+unsigned long Min_Max_Pyramid<T>::get_memory_usage(void) const
+{
+    unsigned long bytes = 0;
+
+    for(unsigned int l=0; l<level_min.size(); l++)
+    {
+        bytes += (level_min[l].capacity() + level_max[l].capacity()) * sizeof(T);
+    }
+
+    return bytes;
+}
+
+#endif // MIN_MAX_PYRAMID_H
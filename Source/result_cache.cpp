@@ -0,0 +1,369 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   R E S U L T   C A C H E   C L A S S                                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "result_cache.h"
+
+// CONSTRUCTOR
+
+/// Creates a Result Cache object on the given directory, which is created if it does not exist.
+/// The data file is hashed once, here. A NULL directory gives a disabled cache, which holds no entry.
+/// @param cacheDirectory Path of the cache directory, or NULL.
+/// @param signalsFileName Path and name of the file containing signals data.
+
+Result_Cache::Result_Cache(const char* cacheDirectory, const char* signalsFileName) : file_hash(0), parameters(NO_OF_STAGES)
+{
+    if(!cacheDirectory)
+    {
+        return;
+    }
+
+    if(!signalsFileName)
+    {
+        signalsFileName = "../Data/signals.dat";
+    }
+
+    if(mkdir(cacheDirectory, 0755) != 0 && errno != EEXIST)
+    {
+        cerr << "SignalAnalyzer Error: ResultCache class." << endl
+             << "Result_Cache(const char*, const char*) method" << endl
+             << "Cannot create cache directory: " << cacheDirectory << endl;
+
+        exit(1);
+    }
+
+    directory = cacheDirectory;
+    file_hash = hash_file(signalsFileName);
+}
+
+
+// void set_ingest_key(const vector<unsigned int>&, const Ingest_Options&) method
+
+/// This method sets the parameters the detected crests, troughs and crossings depend on.
+/// How the file is read, and under which memory budget, makes no difference to them.
+/// @param signalIDList IDs of the signals read, or empty if all the signals on file are.
+/// @param options Pre-filter, detection mode, crossings and time window of the ingest.
+
+void Result_Cache::set_ingest_key(const vector<unsigned int>& signalIDList, const Ingest_Options& options)
+{
+    ostringstream key;
+    key.precision(17);
+
+    key << "signals";
+    if(signalIDList.empty())
+    {
+        key << " all";
+    }
+    for(unsigned int i=0; i<signalIDList.size(); i++)
+    {
+        key << " " << signalIDList[i];
+    }
+
+    key << "; prefilter " << options.prefilter.mode << " " << options.prefilter.window << " " << options.prefilter.threshold
+        << "; detection " << options.detection << "; crossings " << options.crossings
+        << "; noise " << NOISE_THRESHOLD << "; sample " << sizeof(sample_type);
+
+    if(options.read_window)
+    {
+        key << "; window " << options.window_start << " " << options.window_end;
+    }
+
+    parameters[DETECTED_STAGE] = key.str();
+}
+
+
+// void set_filter_key(const Filter_Mode, const Analysis_Plan&) method
+
+/// This method sets the parameters the filtered and cropped crests, troughs and crossings depend on.
+/// @param filterMode Pairwise or consensus filter.
+/// @param plan Plan of the run, with its crop window.
+
+void Result_Cache::set_filter_key(const Filter_Mode filterMode, const Analysis_Plan& plan)
+{
+    ostringstream key;
+    key.precision(17);
+
+    key << "filter " << filterMode << "; epochs " << FILTER_EPOCH << "; crop " << plan.get_crop_start() << " " << plan.get_crop_end();
+
+    parameters[FILTERED_STAGE] = key.str();
+}
+
+
+// void set_results_key(const Phase_Mode, const Analysis_Plan&) method
+
+/// This method sets the parameters the displayed estimates depend on: which of them are requested, and on which basis.
+/// @param phaseMode All pairs or reference phase.
+/// @param plan Plan of the run.
+
+void Result_Cache::set_results_key(const Phase_Mode phaseMode, const Analysis_Plan& plan)
+{
+    ostringstream key;
+
+    key << "phase " << phaseMode << "; outputs ";
+    for(unsigned int o=0; o<NO_OF_OUTPUTS; o++)
+    {
+        key << plan.has_output((Analysis_Output)o);
+    }
+
+    key << "; basis ";
+    for(unsigned int b=CREST_BASIS; b<=CROSSING_BASIS; b++)
+    {
+        key << plan.shows_phase((Phase_Basis)b);
+    }
+    key << " " << plan.get_frequency_basis();
+
+    parameters[RESULTS_STAGE] = key.str();
+}
+
+
+// bool is_enabled(void) const method
+
+/// This method returns true if the cache has a directory.
+
+bool Result_Cache::is_enabled(void) const
+{
+    return !directory.empty();
+}
+
+
+// string get_path(const Cache_Stage) const method
+
+/// This method returns the path of the entry of a stage, for the parameters set so far.
+/// @param stage Stage of the entry.
+
+string Result_Cache::get_path(const Cache_Stage stage) const
+{
+    static const char* const extensions[NO_OF_STAGES] = {"detected", "filtered", "results"};
+
+    ostringstream path;
+    path << directory << "/" << hex << hash_text(get_key(stage)) << "." << extensions[stage];
+
+    return path.str();
+}
+
+
+// bool read_entry(const Cache_Stage, string&) const method
+
+/// This method reads the entry of a stage. Returns false if there is none for the parameters set, or if the cache is disabled.
+/// @param stage Stage of the entry.
+/// @param text Contents of the entry, as written by write_entry().
+
+bool Result_Cache::read_entry(const Cache_Stage stage, string& text) const
+{
+    if(!is_enabled())
+    {
+        return false;
+    }
+
+    Trace_Span span("read_entry", "cache");
+
+    fstream entryFile;
+    entryFile.open(get_path(stage).c_str(), ios::in);
+
+    if(!entryFile.is_open())
+    {
+        return false;
+    }
+
+    string header;
+    getline(entryFile, header);
+
+    if(header != "# " + get_key(stage))
+    {
+        return false;
+    }
+
+    ostringstream contents;
+    contents << entryFile.rdbuf();
+    text = contents.str();
+
+    return true;
+}
+
+
+// void write_entry(const Cache_Stage, const string&) const method
+
+/// This method writes the entry of a stage, under the parameters set so far. As with checkpoints, it is written to a
+/// temporary file that then replaces any previous entry, so an interrupted run never leaves half an entry behind.
+/// @param stage Stage of the entry.
+/// @param text Contents of the entry.
+
+void Result_Cache::write_entry(const Cache_Stage stage, const string& text) const
+{
+    if(!is_enabled())
+    {
+        return;
+    }
+
+    Trace_Span span("write_entry", "cache");
+
+    const string entryFileName = get_path(stage);
+    const string temporaryFileName = entryFileName + ".tmp";
+
+    fstream entryFile;
+    entryFile.open(temporaryFileName.c_str(), ios::out);
+
+    if(!entryFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: ResultCache class." << endl
+             << "void write_entry(const Cache_Stage, const string&) const method" << endl
+             << "Cannot open cache file: " << temporaryFileName << endl;
+
+        exit(1);
+    }
+
+    entryFile << "# " << get_key(stage) << endl << text;
+    entryFile.close();
+
+    if(entryFile.fail() || rename(temporaryFileName.c_str(), entryFileName.c_str()) != 0)
+    {
+        cerr << "SignalAnalyzer Error: ResultCache class." << endl
+             << "void write_entry(const Cache_Stage, const string&) const method" << endl
+             << "Cannot write cache file: " << entryFileName << endl;
+
+        exit(1);
+    }
+}
+
+
+// unsigned long long hash_file(const char* const) const method
+
+/// This method returns the hash of the data file, which is memory-mapped and read once.
+/// The whole 8 byte words of the file are hashed with FNV-1a, one word at a time, in HASH_LANES interleaved lanes.
+/// Each word is mixed before it enters its lane: a multiplication alone only carries a difference upwards, so a change
+/// to the high bytes of a word would stay within a few bits of the lane, where a second change could cancel it.
+/// The mixed hashes of the lanes, the trailing bytes, the size and the modification time of the file are then hashed
+/// together.
+/// @param signalsFileName Path and name of the file containing signals data.
+
+unsigned long long Result_Cache::hash_file(const char* const signalsFileName) const
+{
+    Trace_Span span("hash_file", "cache");
+
+    const int file = open(signalsFileName, O_RDONLY);
+    struct stat file_status;
+
+    if(file < 0 || fstat(file, &file_status) != 0)
+    {
+        cerr << "SignalAnalyzer Error: ResultCache class." << endl
+             << "unsigned long long hash_file(const char* const) const method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+
+    const unsigned long size = file_status.st_size;
+    unsigned long long lane[HASH_LANES];
+    string tail;
+
+    for(unsigned int l=0; l<HASH_LANES; l++)
+    {
+        lane[l] = FNV_OFFSET_BASIS + l;
+    }
+
+    if(size > 0)
+    {
+        void* const mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if(mapping == MAP_FAILED)
+        {
+            cerr << "SignalAnalyzer Error: ResultCache class." << endl
+                 << "unsigned long long hash_file(const char* const) const method" << endl
+                 << "Cannot map Parameter file: "<< signalsFileName  << endl;
+
+            exit(1);
+        }
+
+        const char* const data = (const char*)mapping;
+        const unsigned long stride = HASH_LANES*sizeof(unsigned long long);
+        const unsigned long words_end = size - size % stride;
+
+        for(unsigned long offset=0; offset<words_end; offset+=stride)
+        {
+            for(unsigned int l=0; l<HASH_LANES; l++)
+            {
+                unsigned long long word;
+                memcpy(&word, data + offset + l*sizeof(unsigned long long), sizeof(word));
+
+                lane[l] = (lane[l] ^ mix_word(word)) * FNV_PRIME;
+            }
+        }
+        tail.assign(data + words_end, size - words_end);
+
+        munmap(mapping, size);
+    }
+    close(file);
+
+    ostringstream summary;
+    summary << size << " " << file_status.st_mtim.tv_sec << "." << file_status.st_mtim.tv_nsec;
+    for(unsigned int l=0; l<HASH_LANES; l++)
+    {
+        summary << " " << mix_word(lane[l]);
+    }
+    summary << " " << tail;
+
+    return hash_text(summary.str());
+}
+
+
+// unsigned long long hash_text(const string&) const method
+
+/// This method returns the FNV-1a hash of a string, one byte at a time.
+/// @param text String to be hashed.
+
+unsigned long long Result_Cache::hash_text(const string& text) const
+{
+    unsigned long long hash = FNV_OFFSET_BASIS;
+
+    for(unsigned int i=0; i<text.size(); i++)
+    {
+        hash = (hash ^ (unsigned char)text[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+
+// unsigned long long mix_word(unsigned long long) const method
+
+/// This method returns a word mixed with the splitmix64 finalizer, where every input bit flips about half the output bits.
+/// @param word Word to be mixed.
+
+unsigned long long Result_Cache::mix_word(unsigned long long word) const
+{
+    word = (word ^ (word >> 30)) * MIX_MULTIPLIER_1;
+    word = (word ^ (word >> 27)) * MIX_MULTIPLIER_2;
+
+    return word ^ (word >> 31);
+}
+
+
+// string get_key(const Cache_Stage) const method
+
+/// This method returns the key of the entry of a stage: the hash of the data file, and the parameters of that stage
+/// and of every stage before it.
+/// @param stage Stage of the entry.
+
+string Result_Cache::get_key(const Cache_Stage stage) const
+{
+    ostringstream key;
+    key << "file " << hex << file_hash << dec;
+
+    for(unsigned int s=DETECTED_STAGE; s<=(unsigned int)stage; s++)
+    {
+        key << "; " << parameters[s];
+    }
+
+    return key.str();
+}
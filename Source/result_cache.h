@@ -0,0 +1,93 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   R E S U L T   C A C H E   C L A S S   H E A D E R                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "signal_analyzer_list.h"
+#include "analysis_plan.h"
+
+using namespace std;
+
+//--Intermediates of a run that are kept on disk, each depending on the parameters of the ones before it--//
+enum Cache_Stage
+{
+    DETECTED_STAGE,     // Crests, troughs and crossings of every signal as detected, before filtering and cropping
+    FILTERED_STAGE,     // Crests, troughs and crossings once filtered and cropped
+    RESULTS_STAGE,      // Estimates displayed by the run
+    NO_OF_STAGES
+};
+
+//--64 bit FNV-1a hash--//
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+//--Interleaved hashes over the 8 byte words of the data file, so that the multiplications of one word need not wait
+//  for those of the previous one--//
+#define HASH_LANES 4
+
+//--Multipliers of the splitmix64 finalizer, which spreads every bit of a word over all 64 bits--//
+#define MIX_MULTIPLIER_1 0xbf58476d1ce4e5b9ULL
+#define MIX_MULTIPLIER_2 0x94d049bb133111ebULL
+
+/// On-disk cache of the intermediates and results of a run, in a directory of its own.
+/// Every entry is named after the hash of its key: the hash of the contents of the data file, and the parameters that
+/// the stage of the entry and every stage before it depend on. A changed parameter thus misses only the entries from
+/// the first stage that depends on it, and the run carries on from the deepest entry still valid. The key is also
+/// written at the head of every entry, and checked when it is read, so that two keys with the same hash never mix.
+
+class Result_Cache
+{
+public:
+    Result_Cache(const char*, const char*);
+
+    void set_ingest_key(const vector<unsigned int>&, const Ingest_Options&);
+    void set_filter_key(const Filter_Mode, const Analysis_Plan&);
+    void set_results_key(const Phase_Mode, const Analysis_Plan&);
+
+    bool is_enabled(void) const;
+    string get_path(const Cache_Stage) const;
+
+    bool read_entry(const Cache_Stage, string&) const;
+    void write_entry(const Cache_Stage, const string&) const;
+
+private:
+    unsigned long long hash_file(const char* const) const;
+    unsigned long long hash_text(const string&) const;
+    unsigned long long mix_word(unsigned long long) const;
+    string get_key(const Cache_Stage) const;
+
+    string directory;
+    unsigned long long file_hash;
+
+    //--Parameters of each stage, on top of those of the stages before it--//
+    vector<string> parameters;
+};
+
+#endif // RESULT_CACHE_H
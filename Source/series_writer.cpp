@@ -0,0 +1,286 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S E R I E S   W R I T E R   C L A S S                                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "series_writer.h"
+
+static_assert(sizeof(Series_Header) == SERIES_HEADER_SIZE, "Series_Header must be SERIES_HEADER_SIZE bytes");
+
+// CONSTRUCTOR
+
+/// Creates a Series Writer object for a time series with a fixed number of value columns.
+/// A text series is written to '<name>.dat' row by row. A binary series is written to '<name>.bin' in blocks of
+/// SERIES_BLOCK_ROWS records, after a header whose record count is filled in on close().
+/// Its records store time as a uint32 count of time quanta since the previous record, when every time of the
+/// series lies on the grid t0 + k*time_quantum, and as a float64 otherwise.
+/// @param name Path and name of the output file, without extension.
+/// @param output_format Text or binary output.
+/// @param columns Number of values per row.
+/// @param quantum Time resolution of the series, usually the sampling step. Zero disables the delta encoding.
+
+Series_Writer::Series_Writer(const string& name, const Output_Format output_format, const unsigned int columns, const double quantum)
+{
+    format = output_format;
+    no_columns = columns;
+    time_quantum = quantum;
+
+    if(format == BINARY_OUTPUT)
+    {
+        file_name = name + ".bin";
+    }
+    else
+    {
+        file_name = name + ".dat";
+    }
+
+    //--A binary series is also read back, should its records have to be re-encoded--//
+    if(format == BINARY_OUTPUT)
+    {
+        outputFile.open(file_name.c_str(), ios::in | ios::out | ios::trunc | ios::binary);
+    }
+    else
+    {
+        outputFile.open(file_name.c_str(), ios::out | ios::binary);
+    }
+
+    if(!outputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SeriesWriter class." << endl
+             << "Series_Writer(const string&, const Output_Format, const unsigned int, const double) method" << endl
+             << "Cannot open output file: "<< file_name  << endl;
+
+        exit(1);
+    }
+
+    memset(&header, 0, sizeof(header));
+
+    memcpy(header.magic, SERIES_MAGIC, sizeof(header.magic));
+    header.version = SERIES_VERSION;
+    header.no_columns = no_columns;
+    header.no_records = 0;
+    header.t0 = 0.0;
+    header.time_quantum = time_quantum;
+    header.time_encoding = time_quantum > 0.0 ? DELTA_TICKS : ABSOLUTE_TIME;
+    header.value_bytes = sizeof(double);
+
+    previous_tick = 0.0;
+    written_tick = 0.0;
+
+    //--Placeholder header, completed on close()--//
+    if(format == BINARY_OUTPUT)
+    {
+        outputFile.write((const char*)&header, sizeof(header));
+    }
+}
+
+
+// DESTRUCTOR
+
+/// Closes the output file, if still open.
+
+Series_Writer::~Series_Writer()
+{
+    close();
+}
+
+
+// void write_row(const double, const vector<double>&) method
+
+/// This method adds a row to the series. Rows must be written in time order.
+/// A row may hold fewer values than the number of columns, or NaN for missing values. In text format only the
+/// given values that are not NaN are written. In binary format every column is stored, missing values as NaN.
+/// @param time Time value of the row.
+/// @param row Values of the row.
+
+void Series_Writer::write_row(const double time, const vector<double>& row)
+{
+    if(row.size() > no_columns)
+    {
+        cerr << "SignalAnalyzer Error: SeriesWriter class." << endl
+             << "void write_row(const double, const vector<double>&) method" << endl
+             << "Row size: " << row.size() << " should be <= number of columns: " << no_columns << endl;
+
+        exit(1);
+    }
+
+    if(format == BINARY_OUTPUT)
+    {
+        uint32_t delta = 0;
+
+        if(header.no_records == 0)
+        {
+            header.t0 = time;
+        }
+        else if(header.time_encoding == DELTA_TICKS)
+        {
+            //--Delta encoding is kept only while every time is within 1e-4 ticks of the grid t0 + k*quantum--//
+            const double ticks = (time-header.t0)/time_quantum;
+            const double tick = floor(ticks + 0.5);
+
+            if(fabs(ticks-tick) > 1e-4 || tick < previous_tick || tick-previous_tick > 4294967295.0)
+            {
+                switch_to_absolute_time();
+            }
+            else
+            {
+                delta = (uint32_t)(tick-previous_tick);
+                previous_tick = tick;
+            }
+        }
+
+        header.no_records++;
+        times.push_back(time);
+        deltas.push_back(delta);
+        values.insert(values.end(), row.begin(), row.end());
+        values.resize(times.size()*no_columns, NAN);
+
+        if(times.size() == SERIES_BLOCK_ROWS)
+        {
+            write_block();
+        }
+    }
+    else
+    {
+        outputFile << time;
+        for(unsigned int i=0; i<row.size(); i++)
+        {
+            if(!isnan(row[i]))
+            {
+                outputFile << " " << row[i];
+            }
+        }
+        outputFile << endl;
+    }
+}
+
+
+// void close(void) method
+
+/// This method completes the output file and closes it.
+/// A binary series writes its last block and then the final header over the placeholder.
+
+void Series_Writer::close(void)
+{
+    if(!outputFile.is_open())
+    {
+        return;
+    }
+
+    if(format == BINARY_OUTPUT)
+    {
+        write_block();
+
+        outputFile.seekp(0, ios::beg);
+        outputFile.write((const char*)&header, sizeof(header));
+    }
+
+    outputFile.close();
+}
+
+
+// string get_file_name(void) const method
+
+/// This method returns the path and name of the output file, including extension.
+
+string Series_Writer::get_file_name(void) const
+{
+    return file_name;
+}
+
+
+// void write_block(void) method
+
+/// This method appends the buffered rows to a binary series, in the current time encoding.
+
+void Series_Writer::write_block(void)
+{
+    for(unsigned int i=0; i<times.size(); i++)
+    {
+        if(header.time_encoding == DELTA_TICKS)
+        {
+            outputFile.write((const char*)&deltas[i], sizeof(uint32_t));
+        }
+        else
+        {
+            outputFile.write((const char*)&times[i], sizeof(double));
+        }
+
+        if(no_columns)
+        {
+            outputFile.write((const char*)&values[i*no_columns], no_columns*sizeof(double));
+        }
+    }
+
+    written_tick = previous_tick;
+
+    times.clear();
+    deltas.clear();
+    values.clear();
+}
+
+
+// void switch_to_absolute_time(void) method
+
+/// This method switches a binary series to absolute time, once a row falls off the time grid.
+/// Buffered rows keep their exact times. Records already written are re-encoded in place, last block first,
+/// since each record grows from a uint32 delta to a float64 time. Their times are rebuilt as t0 + tick*quantum,
+/// as a reader of the delta encoding would, so they are within 1e-4 quanta of the times given.
+
+void Series_Writer::switch_to_absolute_time(void)
+{
+    header.time_encoding = ABSOLUTE_TIME;
+
+    const unsigned int no_written = header.no_records - times.size();
+    const unsigned int delta_size = sizeof(uint32_t) + no_columns*sizeof(double);
+    const unsigned int absolute_size = sizeof(double) + no_columns*sizeof(double);
+
+    vector<char> delta_block;
+    vector<char> absolute_block;
+    double tick = written_tick;
+
+    for(unsigned int end=no_written; end>0; )
+    {
+        const unsigned int begin = end > SERIES_BLOCK_ROWS ? end - SERIES_BLOCK_ROWS : 0;
+        const unsigned int no_block = end - begin;
+
+        delta_block.resize(no_block*delta_size);
+        absolute_block.resize(no_block*absolute_size);
+
+        outputFile.seekg(SERIES_HEADER_SIZE + (streamoff)begin*delta_size, ios::beg);
+        outputFile.read(&delta_block[0], delta_block.size());
+
+        for(unsigned int i=no_block; i-->0; )
+        {
+            const char* record = &delta_block[i*delta_size];
+            char* new_record = &absolute_block[i*absolute_size];
+
+            uint32_t delta;
+            memcpy(&delta, record, sizeof(uint32_t));
+
+            const double time = header.t0 + tick*time_quantum;
+            memcpy(new_record, &time, sizeof(double));
+            memcpy(new_record + sizeof(double), record + sizeof(uint32_t), no_columns*sizeof(double));
+
+            tick -= delta;
+        }
+
+        //--The new block starts at or after the old one, so no record not yet read is overwritten--//
+        outputFile.seekp(SERIES_HEADER_SIZE + (streamoff)begin*absolute_size, ios::beg);
+        outputFile.write(&absolute_block[0], absolute_block.size());
+
+        end = begin;
+    }
+
+    outputFile.seekp(0, ios::end);
+}
@@ -0,0 +1,94 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S E R I E S   W R I T E R   C L A S S   H E A D E R                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SERIES_WRITER_H
+#define SERIES_WRITER_H
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+using namespace std;
+
+#define SERIES_HEADER_SIZE 64
+#define SERIES_MAGIC "SASERIES"
+#define SERIES_VERSION 1
+#define SERIES_BLOCK_ROWS 4096
+
+//--Format of the output files--//
+enum Output_Format
+{
+    TEXT_OUTPUT,     // '<name>.dat': One white-space separated row per time value.
+    BINARY_OUTPUT    // '<name>.bin': Series header followed by fixed width records. See Series_Writer.
+};
+
+//--How the time of each record is stored in a binary series file--//
+enum Time_Encoding
+{
+    ABSOLUTE_TIME = 0,   // float64 time.
+    DELTA_TICKS = 1      // uint32 number of time quanta since the previous record (0 for the first record, at t0).
+};
+
+//--Header of a binary series file. All fields are little-endian, SERIES_HEADER_SIZE bytes in total--//
+struct Series_Header
+{
+    char magic[8];              // SERIES_MAGIC, not null terminated.
+    uint32_t version;           // SERIES_VERSION.
+    uint32_t no_columns;        // Values per record.
+    uint64_t no_records;        // Number of records following the header.
+    double t0;                  // Time of the first record.
+    double time_quantum;        // Seconds per tick, for DELTA_TICKS encoding.
+    uint32_t time_encoding;     // Time_Encoding.
+    uint32_t value_bytes;       // Width of each value. Always 8 (float64); missing values are NaN.
+    char reserved[16];
+};
+
+class Series_Writer
+{
+public:
+    Series_Writer(const string&, const Output_Format, const unsigned int, const double);
+    ~Series_Writer();
+
+    void write_row(const double, const vector<double>&);
+    void close(void);
+
+    string get_file_name(void) const;
+
+private:
+    void write_block(void);
+    void switch_to_absolute_time(void);
+
+    string file_name;
+    Output_Format format;
+    unsigned int no_columns;
+    double time_quantum;
+
+    fstream outputFile;
+
+    Series_Header header;
+    double previous_tick;
+    double written_tick;
+
+    vector<double> times;
+    vector<uint32_t> deltas;
+    vector<double> values;
+};
+
+#endif // SERIES_WRITER_H
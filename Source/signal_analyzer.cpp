@@ -23,22 +23,71 @@
 /// Selects the crests and troughs from the signal data.
 /// @param fileName Path and name of the file containing the signal data.
 /// @param sig_id Id of the signal.
+/// @param format Format of the crest and trough output files.
 
-Signal_Analyzer::Signal_Analyzer(const char* const fileName, const unsigned int sig_id)
+Signal_Analyzer::Signal_Analyzer(const char* const fileName, const unsigned int sig_id, const Output_Format format)
 {
     signal_id = sig_id;
+    output_format = format;
+    extrema_output = true;
+    detection_mode = FULL_DETECTION;
+    crossing_detection = false;
+    detect_position = 1;
+    samples_released = false;
+    sample_step = 0.0;
+    dense_base = 0;
+    grid_uniform = false;
+    grid_t0 = 0.0;
+    grid_dt = 0.0;
+    checkpoint_statistics = Signal_Statistics();
+    reduce_position = 0;
+    no_final_detected = 0;
+    checkpoint_position = 1;
 
     extract_signal_data_from_file(fileName);
 
     //--Calculate signal mean--//
-    double sum = accumulate(signal.begin(), signal.end(), 0.0);
-    signal_mean = sum / signal.size();
+    reduce_samples();
 
     select_signal_crest();
     select_signal_trough();
 }
 
 
+// CONSTRUCTOR
+
+/// Creates an empty Signal Analyzer object, initializing the signal ID.
+/// The signal data is then streamed in with append_samples(), and the crests and troughs are
+/// selected with detect_candidates() and finish_detection().
+/// @param sig_id Id of the signal.
+/// @param format Format of the crest and trough output files.
+
+Signal_Analyzer::Signal_Analyzer(const unsigned int sig_id, const Output_Format format)
+{
+    signal_id = sig_id;
+    output_format = format;
+    extrema_output = true;
+    detection_mode = FULL_DETECTION;
+    crossing_detection = false;
+    signal_mean = 0.0;
+    detect_position = 1;
+    samples_released = false;
+    sample_step = 0.0;
+    dense_base = 0;
+    grid_uniform = false;
+    grid_t0 = 0.0;
+    grid_dt = 0.0;
+    checkpoint_statistics = Signal_Statistics();
+    reduce_position = 0;
+    no_final_detected = 0;
+    checkpoint_position = 1;
+
+    reduce_samples();
+    reduce_extrema(signal_crest_index, statistics.crest);
+    reduce_extrema(signal_trough_index, statistics.trough);
+}
+
+
 // void extract_signal_data_from_file(const char* const) method
 
 /// This method extracts the signal data from the file, the location of which is passed as parameter.
@@ -58,40 +107,537 @@ void Signal_Analyzer::extract_signal_data_from_file(const char* const fileName)
         exit(1);
     }
 
+    Column_Parser parser(vector<unsigned int>(1, signal_id));
+    vector<double> values;
     string line;
-    double dNum;
-    size_t found;
+    double t;
+
+    //--Extracting the time and signal data from the file, omitting lines containing '#', and empty lines--//
+    while(getline(inputFile, line))
+    {
+        if(parser.parse_line(line, t, values))
+        {
+            time.push_back(t);
+            signal.push_back(values[0]);
+        }
+    }
+    inputFile.close();
+
+    //--Built once the column is complete, so that every level is allocated once--//
+    pyramid.reserve(signal.size());
+    for(unsigned int i=0; i<signal.size(); i++)
+    {
+        pyramid.append(signal[i]);
+    }
+}
+
+
+// void append_samples(const vector<double>&, const vector<sample_type>&) method
+
+/// This method appends a block of time and signal data to the end of the signal.
+/// @param block_time Time values of the block.
+/// @param block_signal Signal values of the block.
+
+void Signal_Analyzer::append_samples(const vector<double>& block_time, const vector<sample_type>& block_signal)
+{
+    Trace_Span span("append_samples", "ingest", signal_id);
+
+    if(samples_released)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void append_samples(const vector<double>&, const vector<sample_type>&) method" << endl
+             << "Samples of Signal_" << signal_id << " have been released" << endl;
+
+        exit(1);
+    }
+    else if(block_time.size() != block_signal.size())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void append_samples(const vector<double>&, const vector<sample_type>&) method" << endl
+             << "Size of time block: " << block_time.size() << " and signal block: " << block_signal.size() << " do not match" << endl;
 
-    //--Extracting the time and signal data from the file--//
-    do
+        exit(1);
+    }
+
+    for(unsigned int i=0; i<block_time.size(); i++)
     {
-        //--Omitting lines containing '#'--//
-        do
+        double t = block_time[i];
+
+        //--On a resumed signal, times on the uniform grid are computed as Time_Axis does, until one falls off it--//
+        if(grid_uniform)
         {
-            getline(inputFile, line);
-            found = line.find("#");
-        }while(found != string::npos);
+            const double grid_time = grid_t0 + (dense_base + (time.size() - sample_index.size()))*grid_dt;
+
+            if(fabs(t - grid_time) > UNIFORM_TIME_TOLERANCE*grid_dt)
+            {
+                grid_uniform = false;
+            }
+            else
+            {
+                t = grid_time;
+            }
+        }
+
+        time.push_back(t);
+    }
 
-        stringstream ssLine;
-        ssLine << line;
+    const unsigned int first = signal.size();
+    signal.insert(signal.end(), block_signal.begin(), block_signal.end());
 
-        ssLine >> dNum;
-        time.push_back(dNum);
+    if(prefilter.get_delay() > 0)
+    {
+        //--Each sample completes the window of the sample get_delay() positions earlier, which takes its filtered value--//
+        double filtered;
 
-        for(unsigned int i=0; i<signal_id; i++)
+        for(unsigned int i=0; i<block_signal.size(); i++)
         {
-            ssLine >> dNum;
+            if(prefilter.push(block_signal[i], filtered))
+            {
+                signal[first + i - prefilter.get_delay()] = filtered;
+            }
         }
-        signal.push_back(dNum);
+    }
 
-    }while(!inputFile.eof());
-    inputFile.close();
+    //--The pyramid takes the samples once final, so that it agrees with signal, from which range_min_max() reads the ends of a range--//
+    const unsigned int no_final = signal.size() > prefilter.get_delay() ? signal.size() - prefilter.get_delay() : 0;
+
+    while(pyramid.get_no_samples() < no_final)
+    {
+        pyramid.append(signal[pyramid.get_no_samples()]);
+    }
+}
+
+
+// void reserve_samples(const unsigned int) method
+
+/// This method allocates room for a known number of samples, so that appending them does not reallocate the signal.
+/// @param no_samples Number of samples.
+
+void Signal_Analyzer::reserve_samples(const unsigned int no_samples)
+{
+    signal.reserve(no_samples);
+    pyramid.reserve(no_samples);
+}
+
+
+// void set_prefilter(const Prefilter_Options&) method
+
+/// This method sets the median or Hampel filter applied to the samples as they are appended. It must be set before the first append.
+/// Envelopes show the samples as filtered, like every estimate.
+/// @param options Median or Hampel filter, window length and Hampel threshold.
+
+void Signal_Analyzer::set_prefilter(const Prefilter_Options& options)
+{
+    if(!signal.empty())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void set_prefilter(const Prefilter_Options&) method" << endl
+             << "Signal_" << signal_id << " already holds samples" << endl;
+
+        exit(1);
+    }
+
+    prefilter = Sliding_Median(options);
+}
+
+
+// void set_extrema_output(const bool) method
+
+/// This method sets whether the crests and troughs are saved to file, as selected and as filtered.
+/// @param save_extrema False skips the 'S<id>_crest', 'S<id>_trough' and filtered files.
+
+void Signal_Analyzer::set_extrema_output(const bool save_extrema)
+{
+    extrema_output = save_extrema;
+}
+
+
+// void set_detection_mode(const Detection_Mode) method
+
+/// This method sets how the streaming detector searches for crest and trough candidates. It must be set before the first append.
+/// @param mode Full scan of every sample, or coarse scan of the blocks that may hold an extremum.
+
+void Signal_Analyzer::set_detection_mode(const Detection_Mode mode)
+{
+    if(!signal.empty())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void set_detection_mode(const Detection_Mode) method" << endl
+             << "Signal_" << signal_id << " already holds samples" << endl;
+
+        exit(1);
+    }
+
+    detection_mode = mode;
+}
+
+
+// void set_crossing_detection(const bool) method
+
+/// This method sets whether the crossings of the signal mean are found when the detection finishes, for the
+/// crossing based phase and frequency. They need every sample, so the signal must not be resumed from a checkpoint.
+/// @param detect True finds the rising and falling crossings.
+
+void Signal_Analyzer::set_crossing_detection(const bool detect)
+{
+    crossing_detection = detect;
+}
+
+
+// void save_checkpoint(ostream&) const method
+
+/// This method writes the detection state of the signal, so that a later run can resume it on the rows appended to
+/// the file since: the sample statistics, every crest and trough candidate that is final, the last samples from
+/// CHECKPOINT_TAIL samples before the resume point of the detector on, and the window of the pre-filter.
+/// It must be called after finish_detection(), and before the samples are released.
+/// @param checkpointFile Stream the state is written to.
+
+void Signal_Analyzer::save_checkpoint(ostream& checkpointFile) const
+{
+    if(samples_released)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void save_checkpoint(ostream&) const method" << endl
+             << "Samples of Signal_" << signal_id << " have been released" << endl;
+
+        exit(1);
+    }
+
+    const unsigned int first = sample_index.size();
+    const unsigned int tail_begin = max(first, checkpoint_position > CHECKPOINT_TAIL ? checkpoint_position-CHECKPOINT_TAIL : 0);
+
+    //--Sampling grid the times of the next run continue--//
+    const bool uniform = dense_base > 0 ? grid_uniform : time.is_uniform() && time.size() > 1;
+    const double t0 = dense_base > 0 ? grid_t0 : (time.size() ? time[0] : 0.0);
+
+    checkpointFile << "signal " << signal_id << " " << get_sample_step() << endl
+                   << "grid " << uniform << " " << t0 << " " << get_sample_step() << endl
+                   << "statistics " << statistics.no_samples << " " << statistics.sum << " " << statistics.min << " " << statistics.max << endl
+                   << "candidates " << no_final_detected << endl;
+
+    for(unsigned int i=0; i<no_final_detected; i++)
+    {
+        checkpointFile << detected[i].index << " " << detected[i].crest << " "
+                       << sample_time(detected[i].index) << " " << sample_value(detected[i].index) << endl;
+    }
+
+    checkpointFile << "tail " << dense_base + (tail_begin-first) << " " << dense_base + (checkpoint_position-first) << " "
+                   << time.size()-tail_begin << endl;
+
+    for(unsigned int i=tail_begin; i<time.size(); i++)
+    {
+        checkpointFile << time[i] << " " << signal[i] << endl;
+    }
+
+    vector<double> window;
+    prefilter.get_window(window);
+
+    checkpointFile << "prefilter " << prefilter.get_no_replaced() << " " << window.size();
+    for(unsigned int i=0; i<window.size(); i++)
+    {
+        checkpointFile << " " << window[i];
+    }
+    checkpointFile << endl << "end" << endl;
+}
+
+
+// void load_checkpoint(istream&) method
+
+/// This method restores the detection state written by save_checkpoint() into an empty signal, with the same pre-filter.
+/// The candidates before the tail are held as sparse samples, and the tail and the samples appended afterwards densely,
+/// so that the detector resumes where it stopped and the statistics extend the saved ones.
+/// @param checkpointFile Stream the state is read from.
+
+void Signal_Analyzer::load_checkpoint(istream& checkpointFile)
+{
+    if(!signal.empty())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void load_checkpoint(istream&) method" << endl
+             << "Signal_" << signal_id << " already holds samples" << endl;
+
+        exit(1);
+    }
+
+    string signal_keyword, grid_keyword, statistics_keyword, candidates_keyword, tail_keyword, prefilter_keyword, end_keyword;
+    unsigned int id;
+    unsigned long no_replaced;
+    unsigned int no_candidates;
+    unsigned int tail_index, resume_index, no_tail;
+    unsigned int no_window;
+
+    checkpointFile >> signal_keyword >> id >> sample_step
+                   >> grid_keyword >> grid_uniform >> grid_t0 >> grid_dt
+                   >> statistics_keyword >> checkpoint_statistics.no_samples >> checkpoint_statistics.sum
+                   >> checkpoint_statistics.min >> checkpoint_statistics.max
+                   >> candidates_keyword >> no_candidates;
+
+    if(!checkpointFile || signal_keyword != "signal" || id != signal_id || grid_keyword != "grid" || statistics_keyword != "statistics" || candidates_keyword != "candidates")
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void load_checkpoint(istream&) method" << endl
+             << "Malformed checkpoint of Signal_" << signal_id << endl;
+
+        exit(1);
+    }
+
+    vector<double> candidate_time(no_candidates);
+    vector<double> candidate_value(no_candidates);
+
+    detected.resize(no_candidates);
+    for(unsigned int i=0; i<no_candidates; i++)
+    {
+        checkpointFile >> detected[i].index >> detected[i].crest >> candidate_time[i] >> candidate_value[i];
+    }
+
+    checkpointFile >> tail_keyword >> tail_index >> resume_index >> no_tail;
+
+    //--Appended times are put on the sampling grid by append_samples()--//
+    time.make_explicit();
+
+    //--Candidates before the tail are held sparsely, the others are among the tail samples--//
+    for(unsigned int i=0; i<no_candidates && detected[i].index < tail_index; i++)
+    {
+        sample_index.push_back(detected[i].index);
+        time.push_back(candidate_time[i]);
+        signal.push_back(candidate_value[i]);
+    }
+    dense_base = tail_index;
+
+    double t;
+    double value;
+
+    for(unsigned int i=0; i<no_tail; i++)
+    {
+        checkpointFile >> t >> value;
+
+        time.push_back(t);
+        signal.push_back(value);
+    }
+
+    checkpointFile >> prefilter_keyword >> no_replaced >> no_window;
+
+    vector<double> window(checkpointFile ? no_window : 0);
+    for(unsigned int i=0; i<window.size(); i++)
+    {
+        checkpointFile >> window[i];
+    }
+    checkpointFile >> end_keyword;
+
+    if(!checkpointFile || tail_keyword != "tail" || prefilter_keyword != "prefilter" || end_keyword != "end" || resume_index < tail_index)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void load_checkpoint(istream&) method" << endl
+             << "Malformed checkpoint of Signal_" << signal_id << endl;
+
+        exit(1);
+    }
+
+    prefilter.restore(window, no_replaced);
+
+    detect_position = sample_index.size() + (resume_index-tail_index);
+    reduce_position = time.size();
+}
+
+
+// void save_extrema_state(ostream&) const method
+
+/// This method writes the crests, troughs and crossings of the signal as they stand, for instance once filtered and
+/// cropped, so that a later run can carry on from them with load_extrema_state() without reading the data file.
+/// @param stateFile Stream the state is written to.
+
+void Signal_Analyzer::save_extrema_state(ostream& stateFile) const
+{
+    stateFile << "signal " << signal_id << " " << get_sample_step() << endl
+              << "statistics " << statistics.no_samples << " " << statistics.sum << " " << statistics.min << " " << statistics.max << endl
+              << "crests " << signal_crest_index.size() << endl;
+
+    for(unsigned int i=0; i<signal_crest_index.size(); i++)
+    {
+        stateFile << signal_crest_index[i] << " " << sample_time(signal_crest_index[i]) << " " << sample_value(signal_crest_index[i]) << endl;
+    }
+
+    stateFile << "troughs " << signal_trough_index.size() << endl;
+
+    for(unsigned int i=0; i<signal_trough_index.size(); i++)
+    {
+        stateFile << signal_trough_index[i] << " " << sample_time(signal_trough_index[i]) << " " << sample_value(signal_trough_index[i]) << endl;
+    }
+
+    stateFile << "crossings " << rising_crossing.size() << " " << falling_crossing.size() << endl;
+
+    for(unsigned int i=0; i<rising_crossing.size(); i++)
+    {
+        stateFile << rising_crossing[i] << endl;
+    }
+    for(unsigned int i=0; i<falling_crossing.size(); i++)
+    {
+        stateFile << falling_crossing[i] << endl;
+    }
+    stateFile << "end" << endl;
+}
+
+
+// void load_extrema_state(istream&) method
+
+/// This method restores the state written by save_extrema_state() into an empty signal. The signal is left as
+/// release_samples() leaves it, holding only its extrema, so every estimate works as it did on the saved signal.
+/// The crests and troughs are saved in file as finish_detection() saves them, unless extrema output is off.
+/// @param stateFile Stream the state is read from.
+
+void Signal_Analyzer::load_extrema_state(istream& stateFile)
+{
+    if(!signal.empty())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void load_extrema_state(istream&) method" << endl
+             << "Signal_" << signal_id << " already holds samples" << endl;
+
+        exit(1);
+    }
+
+    string signal_keyword, statistics_keyword, crests_keyword, troughs_keyword, crossings_keyword, end_keyword;
+    unsigned int id;
+    unsigned int no_crests = 0;
+    unsigned int no_troughs = 0;
+    unsigned int no_rising = 0;
+    unsigned int no_falling = 0;
+
+    stateFile >> signal_keyword >> id >> sample_step
+              >> statistics_keyword >> statistics.no_samples >> statistics.sum >> statistics.min >> statistics.max
+              >> crests_keyword >> no_crests;
+
+    //--Crests and troughs, each with its sample index, time and value--//
+    vector<vector<double> > extrema(2);
+    vector<unsigned int> extrema_index[2];
+
+    for(unsigned int i=0; stateFile && i<no_crests; i++)
+    {
+        unsigned int index;
+        double t, value;
+
+        stateFile >> index >> t >> value;
+        extrema_index[0].push_back(index);
+        extrema[0].push_back(t);
+        extrema[0].push_back(value);
+    }
+
+    stateFile >> troughs_keyword >> no_troughs;
+
+    for(unsigned int i=0; stateFile && i<no_troughs; i++)
+    {
+        unsigned int index;
+        double t, value;
+
+        stateFile >> index >> t >> value;
+        extrema_index[1].push_back(index);
+        extrema[1].push_back(t);
+        extrema[1].push_back(value);
+    }
+
+    stateFile >> crossings_keyword >> no_rising >> no_falling;
+
+    rising_crossing.resize(stateFile ? no_rising : 0);
+    falling_crossing.resize(stateFile ? no_falling : 0);
+    for(unsigned int i=0; i<rising_crossing.size(); i++)
+    {
+        stateFile >> rising_crossing[i];
+    }
+    for(unsigned int i=0; i<falling_crossing.size(); i++)
+    {
+        stateFile >> falling_crossing[i];
+    }
+    stateFile >> end_keyword;
+
+    if(!stateFile || signal_keyword != "signal" || id != signal_id || statistics_keyword != "statistics" || crests_keyword != "crests"
+       || troughs_keyword != "troughs" || crossings_keyword != "crossings" || end_keyword != "end")
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void load_extrema_state(istream&) method" << endl
+             << "Malformed extrema state of Signal_" << signal_id << endl;
+
+        exit(1);
+    }
+
+    statistics.mean = statistics.no_samples ? statistics.sum/statistics.no_samples : 0.0;
+    signal_mean = statistics.mean;
+
+    //--Crests and troughs merged in sample order, as release_samples() keeps them--//
+    time.make_explicit();
+
+    unsigned int c = 0;
+    unsigned int t = 0;
+
+    while(c < no_crests || t < no_troughs)
+    {
+        const bool crest = t == no_troughs || (c < no_crests && extrema_index[0][c] < extrema_index[1][t]);
+        const unsigned int k = crest ? c++ : t++;
+        const unsigned int e = crest ? 0 : 1;
+
+        sample_index.push_back(extrema_index[e][k]);
+        time.push_back(extrema[e][2*k]);
+        signal.push_back(extrema[e][2*k+1]);
+    }
+
+    signal_crest_index.swap(extrema_index[0]);
+    signal_trough_index.swap(extrema_index[1]);
+
+    dense_base = statistics.no_samples;
+    samples_released = true;
+
+    reduce_extrema(signal_crest_index, statistics.crest);
+    reduce_extrema(signal_trough_index, statistics.trough);
+
+    //--Save crest and trough data in file, as after detection--//
+    save_extrema("_crest", signal_crest_index);
+    save_extrema("_trough", signal_trough_index);
+}
+
+
+// void release_samples(void) method
+
+/// This method frees the signal data once the crests and troughs have been selected, keeping only the time and value
+/// of the extrema. Crests and troughs keep their sample indices, so filtering against other signals, cropping, and
+/// the amplitude, offset, frequency and phase estimates work as before. The signal can no longer be appended to,
+/// searched for extrema, or plotted as an envelope.
+
+void Signal_Analyzer::release_samples(void)
+{
+    if(samples_released)
+    {
+        return;
+    }
+
+    vector<unsigned int> kept_index(signal_crest_index.size() + signal_trough_index.size());
+    merge(signal_crest_index.begin(), signal_crest_index.end(), signal_trough_index.begin(), signal_trough_index.end(), kept_index.begin());
+
+    Time_Axis kept_time;
+    vector<sample_type> kept_signal;
+
+    kept_time.make_explicit();
+    kept_signal.reserve(kept_index.size());
+    for(unsigned int i=0; i<kept_index.size(); i++)
+    {
+        kept_time.push_back(sample_time(kept_index[i]));
+        kept_signal.push_back(sample_value(kept_index[i]));
+    }
+
+    sample_step = get_sample_step();
+    dense_base += time.size() - sample_index.size();
+
+    //--Swap with the compact copies, so that the sample buffers are freed, not just cleared--//
+    swap(time, kept_time);
+    signal.swap(kept_signal);
+    sample_index.swap(kept_index);
+    pyramid = Min_Max_Pyramid<sample_type>();
+
+    samples_released = true;
 }
 
 
 // void crop_length(const double, const double)
 
-/// This method crops a signal by removing all crests and troughs outside the limit [lower_limit:upper_limit].
+/// This method crops a signal by removing all crests, troughs and crossings outside the limit [lower_limit:upper_limit].
 /// @param lower_limit Time value below which the signal needs to be cropped.
 /// @param upper_limit Time value above which the signal needs to be cropped.
 
@@ -103,79 +649,62 @@ void Signal_Analyzer::crop_length(const double lower_limit, const double upper_l
     //cout << endl << "Signal_" << signal_id << endl;
 
     //--Remove crests with t < lower_limit--//
-    while(signal_crest_time.front() < lower_limit)
+    while(!signal_crest_index.empty() && sample_time(signal_crest_index.front()) < lower_limit)
     {
         crest_updated = true;
-        //cout << " Removed Crest: " << signal_crest.front() << "  @ t: " << signal_crest_time.front() << endl;
+        //cout << " Removed Crest: " << sample_value(signal_crest_index.front()) << "  @ t: " << sample_time(signal_crest_index.front()) << endl;
 
-        signal_crest.erase(signal_crest.begin());
-        signal_crest_time.erase(signal_crest_time.begin());
+        signal_crest_index.erase(signal_crest_index.begin());
     }
 
     //--Remove crests with t > upper_limit--//
-    while(signal_crest_time.back() > upper_limit)
+    while(!signal_crest_index.empty() && sample_time(signal_crest_index.back()) > upper_limit)
     {
         crest_updated = true;
-        //cout << " Removed Crest: " << signal_crest.back() << "  @ t: " << signal_crest_time.back() << endl;
+        //cout << " Removed Crest: " << sample_value(signal_crest_index.back()) << "  @ t: " << sample_time(signal_crest_index.back()) << endl;
 
-        signal_crest.pop_back();
-        signal_crest_time.pop_back();
+        signal_crest_index.pop_back();
     }
 
     //--Remove troughs with t < lower_limit--//
-    while(signal_trough_time.front() < lower_limit)
+    while(!signal_trough_index.empty() && sample_time(signal_trough_index.front()) < lower_limit)
     {
         trough_updated = true;
-        //cout << " Removed Trough: " << signal_trough.front() << "  @ t: " << signal_trough_time.front() << endl;
+        //cout << " Removed Trough: " << sample_value(signal_trough_index.front()) << "  @ t: " << sample_time(signal_trough_index.front()) << endl;
 
-        signal_trough.erase(signal_trough.begin());
-        signal_trough_time.erase(signal_trough_time.begin());
+        signal_trough_index.erase(signal_trough_index.begin());
     }
 
     //--Remove troughs with t > upper_limit--//
-    while(signal_trough_time.back() > upper_limit)
+    while(!signal_trough_index.empty() && sample_time(signal_trough_index.back()) > upper_limit)
     {
         trough_updated = true;
-        //cout << " Removed Trough: " << signal_trough.back() << "  @ t: " << signal_trough_time.back() << endl;
+        //cout << " Removed Trough: " << sample_value(signal_trough_index.back()) << "  @ t: " << sample_time(signal_trough_index.back()) << endl;
 
-        signal_trough.pop_back();
-        signal_trough_time.pop_back();
+        signal_trough_index.pop_back();
     }
 
     //cout << endl;
 
+    //--Remove crossings outside the limit--//
+    rising_crossing.erase(upper_bound(rising_crossing.begin(), rising_crossing.end(), upper_limit), rising_crossing.end());
+    rising_crossing.erase(rising_crossing.begin(), lower_bound(rising_crossing.begin(), rising_crossing.end(), lower_limit));
+    falling_crossing.erase(upper_bound(falling_crossing.begin(), falling_crossing.end(), upper_limit), falling_crossing.end());
+    falling_crossing.erase(falling_crossing.begin(), lower_bound(falling_crossing.begin(), falling_crossing.end(), lower_limit));
+
+    reduce_extrema(signal_crest_index, statistics.crest);
+    reduce_extrema(signal_trough_index, statistics.trough);
+
     if(crest_updated)
     {
         //--Save updated crest data in file.
-        fstream outputFile;
-        stringstream ss;
-
-        ss << "../Output/S" << signal_id << "_filtered_crest.dat";
-        remove(ss.str().c_str());
-        outputFile.open(ss.str().c_str(), ios::out);
-
-        for(unsigned int i=0; i<signal_crest.size(); i++)
-        {
-            outputFile << signal_crest_time[i] << " " << signal_crest[i] << endl;
-        }
-        outputFile.close();
+        save_extrema("_filtered_crest", signal_crest_index);
     }
 
     if(trough_updated)
     {
         //--Save filtered trough data in file.
-        fstream outputFile;
-        stringstream ss;
-
-        ss << "../Output/S" << signal_id << "_filtered_trough.dat";
-        remove(ss.str().c_str());
-        outputFile.open(ss.str().c_str(), ios::out);
-
-        for(unsigned int i=0; i<signal_trough.size(); i++)
-        {
-            outputFile << signal_trough_time[i] << " " << signal_trough[i] << endl;
-        }
-        outputFile.close();
+        save_extrema("_filtered_trough", signal_trough_index);
     }
 }
 
@@ -190,7 +719,8 @@ void Signal_Analyzer::crop_length(const double lower_limit, const double upper_l
 
 bool Signal_Analyzer::is_previous_signal_lower(const unsigned int index) const
 {
-    if(index != 1)
+    //--The first sample held densely has no predecessor--//
+    if(index != sample_index.size()+1)
     {
         if(signal[index] == signal[index-1])
         {
@@ -239,7 +769,8 @@ bool Signal_Analyzer::is_previous_signal_lower(const unsigned int index) const
 
 bool Signal_Analyzer::is_previous_signal_higher(const unsigned int index) const
 {
-    if(index != 1)
+    //--The first sample held densely has no predecessor--//
+    if(index != sample_index.size()+1)
     {
         if(signal[index] == signal[index-1])
         {
@@ -278,6 +809,48 @@ bool Signal_Analyzer::is_previous_signal_higher(const unsigned int index) const
 }
 
 
+// bool is_crest_candidate(const unsigned int) const method
+
+/// This method returns true if the signal point could be a crest of the signal, regardless of the signal mean.
+/// The next signal point must already be available.
+/// @param i Index of a point on a time varied signal.
+
+bool Signal_Analyzer::is_crest_candidate(const unsigned int i) const
+{
+    //--Naive noise filter
+    if(fabs(signal[i]-signal[i-1])<=NOISE_THRESHOLD && fabs(signal[i]-signal[i+1])<=NOISE_THRESHOLD)
+    {
+        if(signal[i] > signal[i+1])
+        {
+            return(is_previous_signal_lower(i));
+        }
+    }
+
+    return false;
+}
+
+
+// bool is_trough_candidate(const unsigned int) const method
+
+/// This method returns true if the signal point could be a trough of the signal, regardless of the signal mean.
+/// The next signal point must already be available.
+/// @param i Index of a point on a time varied signal.
+
+bool Signal_Analyzer::is_trough_candidate(const unsigned int i) const
+{
+    //--Naive noise filter
+    if(fabs(signal[i]-signal[i-1])<=NOISE_THRESHOLD && fabs(signal[i]-signal[i+1])<=NOISE_THRESHOLD)
+    {
+        if(signal[i] < signal[i+1])
+        {
+            return(is_previous_signal_higher(i));
+        }
+    }
+
+    return false;
+}
+
+
 // void select_signal_crest(void) method
 
 /// This method searches through the signal data and selets all potential signal points that could be crests of the signal.
@@ -286,32 +859,16 @@ void Signal_Analyzer::select_signal_crest(void)
 {
     for(unsigned int i=1; i<time.size()-1; i++)
     {
-        //--Naive noise filter
-        if(signal[i] > signal_mean && (fabs(signal[i]-signal[i-1])<=NOISE_THRESHOLD && fabs(signal[i]-signal[i+1])<=NOISE_THRESHOLD))
+        if(signal[i] > signal_mean && is_crest_candidate(i))
         {
-            if(signal[i] > signal[i+1])
-            {
-                if(is_previous_signal_lower(i))
-                {
-                    signal_crest.push_back(signal[i]);
-                    signal_crest_time.push_back(time[i]);
-                }
-            }
+            signal_crest_index.push_back(i);
         }
     }
 
-    //--Save selected crest data in file--//
-    fstream outputFile;
-    stringstream ss;
-
-    ss << "../Output/S" << signal_id << "_crest.dat";
-    outputFile.open(ss.str().c_str(), ios::out);
+    reduce_extrema(signal_crest_index, statistics.crest);
 
-    for(unsigned int i=0; i<signal_crest.size(); i++)
-    {
-        outputFile << signal_crest_time[i] << " " << signal_crest[i] << endl;
-    }
-    outputFile.close();
+    //--Save selected crest data in file--//
+    save_extrema("_crest", signal_crest_index);
 }
 
 
@@ -323,119 +880,371 @@ void Signal_Analyzer::select_signal_trough(void)
 {
     for(unsigned int i=1; i<time.size()-1; i++)
     {
-        //--Naive noise filter
-        if(signal[i] < signal_mean && (fabs(signal[i]-signal[i-1])<=NOISE_THRESHOLD && fabs(signal[i]-signal[i+1])<=NOISE_THRESHOLD))
+        if(signal[i] < signal_mean && is_trough_candidate(i))
         {
-            if(signal[i] < signal[i+1])
-            {
-                if(is_previous_signal_higher(i))
-                {
-                    signal_trough.push_back(signal[i]);
-                    signal_trough_time.push_back(time[i]);
-                }
-            }
+            signal_trough_index.push_back(i);
         }
     }
 
+    reduce_extrema(signal_trough_index, statistics.trough);
+
     //--Save selected trough data in file--//
-    fstream outputFile;
-    stringstream ss;
+    save_extrema("_trough", signal_trough_index);
+}
+
+
+// void detect_candidates(vector<Extremum>&) method
+
+/// This method scans the signal points appended since the previous call, and adds every point that could be a
+/// crest or a trough to the candidates vector. The signal mean is not yet known while the signal is streamed in,
+/// so the mean test of select_signal_crest() and select_signal_trough() is applied later by finish_detection().
+/// @param candidates Vector to which the newly found candidates are appended.
+
+void Signal_Analyzer::detect_candidates(vector<Extremum>& candidates)
+{
+    Trace_Span span("detect_candidates", "ingest", signal_id);
+
+    //--Samples still waiting for the rest of their pre-filter window may change--//
+    scan_candidates(signal.size() - min((unsigned int)signal.size(), prefilter.get_delay()), false, candidates);
+}
+
 
-    ss << "../Output/S" << signal_id << "_trough.dat";
-    outputFile.open(ss.str().c_str(), ios::out);
+// void scan_candidates(const unsigned int, const bool, vector<Extremum>&) method
 
-    for(unsigned int i=0; i<signal_trough.size(); i++)
+/// This method scans the signal points from the previous scan up to the given end, and adds every point that could
+/// be a crest or a trough to the candidates vector.
+/// @param end Number of leading signal points that are final.
+/// @param last True if no more signal points will be appended.
+/// @param candidates Vector to which the newly found candidates are appended.
+
+void Signal_Analyzer::scan_candidates(const unsigned int end, const bool last, vector<Extremum>& candidates)
+{
+    if(detection_mode == COARSE_DETECTION)
     {
-        outputFile << signal_trough_time[i] << " " << signal_trough[i] << endl;
+        scan_blocks(end, last, candidates);
+        return;
+    }
+
+    Extremum candidate;
+
+    //--The last signal point cannot be tested until its successor arrives--//
+    for(; detect_position+1 < end; detect_position++)
+    {
+        const unsigned int i = detect_position;
+
+        if(is_crest_candidate(i) || is_trough_candidate(i))
+        {
+            candidate.index = dense_base + (i - sample_index.size());
+            candidate.crest = signal[i] > signal[i+1];
+
+            candidates.push_back(candidate);
+        }
     }
-    outputFile.close();
 }
 
 
-// void filter_signal_crest(const Signal_Analyzer&) method
+// void scan_blocks(const unsigned int, const bool, vector<Extremum>&) method
 
-/// This method filters the crests vector of the signal.
-/// It does so by retaining the highest crest that lies between two concurrent crests of the reference signal.
-/// @param ref_sig A SignalAnalyzer object used as a reference to filter the crests of the signal.
+/// This method is the coarse version of scan_candidates(). The signal is cut into blocks of COARSE_BLOCK_SIZE samples, and
+/// only the samples of a block whose maximum is not below the maxima of the blocks on either side are tested for crests,
+/// and only those of a block whose minimum is not above their minima for troughs. Every other block costs a pass for its
+/// minimum and maximum. A block is scanned once the block after it is final, so that the result does not depend on how
+/// the samples arrive. On a clean signal with a few blocks per half period, every crest is the maximum of its block and of
+/// the blocks on either side, and the candidates are those of the full scan. On a noisy signal, the noise candidates
+/// away from the extrema are not found.
+/// @param end Number of leading signal points that are final.
+/// @param last True if no more signal points will be appended, so that the last block has no successor to wait for.
+/// @param candidates Vector to which the newly found candidates are appended.
 
-void Signal_Analyzer::filter_signal_crest(const Signal_Analyzer& ref_sig)
+void Signal_Analyzer::scan_blocks(const unsigned int end, const bool last, vector<Extremum>& candidates)
 {
-    double temp_time;
-    double temp_index;
+    const unsigned int first = sample_index.size();
 
-    //--Weeding out noisy signal crest by selecting the highest signal crest between two reference signal ref_sig's crests--//
-    for(unsigned int i=0; i<ref_sig.get_crest_time_size()-1; i++)
+    //--Blocks are aligned on sample indices. Before a resumed signal's first block, the checkpoint tail holds the block before it--//
+    unsigned int block_begin = detect_position - (dense_base + (detect_position-first)) % COARSE_BLOCK_SIZE;
+    block_begin = max(first, block_begin);
+
+    bool has_previous = block_begin >= first + COARSE_BLOCK_SIZE;
+    sample_type previous_min = 0;
+    sample_type previous_max = 0;
+
+    if(has_previous)
+    {
+        find_block_extremes(block_begin-COARSE_BLOCK_SIZE, block_begin, previous_min, previous_max);
+    }
+
+    //--Extremes of the block being scanned, carried over from the previous block as its successor--//
+    bool has_block = false;
+    sample_type block_min = 0;
+    sample_type block_max = 0;
+
+    Extremum candidate;
+
+    //--The last signal point cannot be tested until its successor arrives--//
+    while(detect_position+1 < end && (last || block_begin + 2*COARSE_BLOCK_SIZE <= end))
     {
-        vector<double> multiple_crests_time;
-        vector<unsigned int> crest_index;
+        const unsigned int block_end = block_begin + COARSE_BLOCK_SIZE;
+
+        if(!has_block)
+        {
+            find_block_extremes(block_begin, min(block_end, end), block_min, block_max);
+        }
+
+        //--A missing block on either side does not rule a block out--//
+        sample_type next_min = block_min;
+        sample_type next_max = block_max;
+
+        has_block = block_end < end;
+        if(has_block)
+        {
+            find_block_extremes(block_end, min(block_end+COARSE_BLOCK_SIZE, end), next_min, next_max);
+        }
+
+        const bool crest_block = (!has_previous || block_max >= previous_max) && block_max >= next_max;
+        const bool trough_block = (!has_previous || block_min <= previous_min) && block_min <= next_min;
+
+        const unsigned int block_stop = min(block_end, end-1);
 
-        //--Collect all the signal crests between two concurrent ref_sig crests--//
-        for(unsigned int j=0; j<signal_crest_time.size(); j++)
+        for(unsigned int i=detect_position; (crest_block || trough_block) && i<block_stop; i++)
         {
-            if(ref_sig.get_crest_time(i) <= signal_crest_time[j] && signal_crest_time[j] <= ref_sig.get_crest_time(i+1))
+            if((crest_block && is_crest_candidate(i)) || (trough_block && is_trough_candidate(i)))
             {
-                multiple_crests_time.push_back(signal_crest_time[j]);
-                crest_index.push_back(j);
+                candidate.index = dense_base + (i - first);
+                candidate.crest = signal[i] > signal[i+1];
+
+                candidates.push_back(candidate);
             }
-            else if(signal_crest_time[j] > ref_sig.get_crest_time(i+1))
+        }
+
+        detect_position = block_stop;
+        block_begin = block_end;
+
+        has_previous = true;
+        previous_min = block_min;
+        previous_max = block_max;
+        block_min = next_min;
+        block_max = next_max;
+    }
+}
+
+
+// void find_block_extremes(const unsigned int, const unsigned int, sample_type&, sample_type&) const method
+
+/// This method returns the minimum and the maximum of a block of signal points.
+/// @param begin Position of the first signal point of the block.
+/// @param end Position past the last signal point of the block, greater than begin.
+/// @param block_min Minimum of the block.
+/// @param block_max Maximum of the block.
+
+void Signal_Analyzer::find_block_extremes(const unsigned int begin, const unsigned int end, sample_type& block_min, sample_type& block_max) const
+{
+    block_min = signal[begin];
+    block_max = signal[begin];
+
+    for(unsigned int i=begin+1; i<end; i++)
+    {
+        block_min = signal[i] < block_min ? signal[i] : block_min;
+        block_max = signal[i] > block_max ? signal[i] : block_max;
+    }
+}
+
+
+// void finish_detection(const vector<Extremum>&) method
+
+/// This method completes a streamed detection. It calculates the signal mean and retains the crest candidates
+/// above the mean and the trough candidates below it, as select_signal_crest() and select_signal_trough() do.
+/// @param candidates All the candidates found by detect_candidates(), in time order.
+
+void Signal_Analyzer::finish_detection(const vector<Extremum>& candidates)
+{
+    Trace_Span span("finish_detection", "ingest", signal_id);
+
+    detected.insert(detected.end(), candidates.begin(), candidates.end());
+    no_final_detected = detected.size();
+    checkpoint_position = detect_position;
+
+    //--The last samples, which the pre-filter leaves as they are, are final only now--//
+    scan_candidates(signal.size(), true, detected);
+
+    while(pyramid.get_no_samples() < signal.size())
+    {
+        pyramid.append(signal[pyramid.get_no_samples()]);
+    }
+
+    //--Calculate signal mean--//
+    reduce_samples();
+
+    //--Candidates restored from a checkpoint are selected again, against the mean of all the samples so far--//
+    for(unsigned int i=0; i<detected.size(); i++)
+    {
+        const double value = sample_value(detected[i].index);
+
+        if(detected[i].crest && value > signal_mean)
+        {
+            signal_crest_index.push_back(detected[i].index);
+        }
+        else if(!detected[i].crest && value < signal_mean)
+        {
+            signal_trough_index.push_back(detected[i].index);
+        }
+    }
+
+    reduce_extrema(signal_crest_index, statistics.crest);
+    reduce_extrema(signal_trough_index, statistics.trough);
+
+    if(crossing_detection)
+    {
+        detect_crossings();
+    }
+
+    //--Save selected crest and trough data in file--//
+    save_extrema("_crest", signal_crest_index);
+    save_extrema("_trough", signal_trough_index);
+}
+
+
+// void detect_crossings(void) method
+
+/// This method finds the rising and falling crossings of the signal mean, the level that also splits the crests from
+/// the troughs. A crossing counts once two samples in a row clear the band of calculate_cycle_band() on the other side
+/// of the mean, so noise around the mean and single sample spikes add no crossings. Its time is interpolated linearly
+/// between the last two samples on either side of the mean before the band was cleared. The samples are compared against
+/// the edges of the band in blocks of CROSSING_BLOCK, into bit masks built without branches, and only the bits where the
+/// band is cleared are visited.
+
+void Signal_Analyzer::detect_crossings(void)
+{
+    Trace_Span span("detect_crossings", "ingest", signal_id);
+
+    rising_crossing.clear();
+    falling_crossing.clear();
+
+    const double level = signal_mean;
+    const double band = calculate_cycle_band();
+    const double upper = level + band;
+    const double lower = level - band;
+
+    const unsigned int n = signal.size();
+    int state = 0;              // 1 above the band, -1 below it, 0 not yet known
+
+    for(unsigned int block=sample_index.size(); block<n; block+=CROSSING_BLOCK)
+    {
+        const unsigned int block_size = min((unsigned int)CROSSING_BLOCK, n-block);
+
+        //--Bit k is set if samples block+k and block+k+1 both lie above (below) the band--//
+        unsigned long long above = 0;
+        unsigned long long below = 0;
+
+        for(unsigned int k=0; k<block_size && block+k+1<n; k++)
+        {
+            above |= (unsigned long long)(signal[block+k] > upper && signal[block+k+1] > upper) << k;
+            below |= (unsigned long long)(signal[block+k] < lower && signal[block+k+1] < lower) << k;
+        }
+
+        unsigned long long unvisited = ~0ull;
+
+        while(true)
+        {
+            const unsigned long long cleared = (state == 1 ? below : (state == -1 ? above : above | below)) & unvisited;
+
+            if(cleared == 0)
             {
                 break;
             }
-        }
 
-        //--If there exists more than one signal crest between the current pair of adjacent ref_sig crests,
-        //--then sort them in assending order, based on the height of the signal crest--//
-        if(multiple_crests_time.size()>1)
-        {
-            for(unsigned int k=0; k<crest_index.size()-1; k++)
+            const unsigned int k = __builtin_ctzll(cleared);
+            const int side = (above >> k) & 1 ? 1 : -1;
+
+            if(state != 0)
             {
-                if(signal_crest[crest_index[k]] >= signal_crest[crest_index[k+1]])
-                {
-                    temp_time = multiple_crests_time[k];
-                    multiple_crests_time[k] = multiple_crests_time[k+1];
-                    multiple_crests_time[k+1] = temp_time;
+                //--Walk back to the last pair of samples on either side of the mean. The band was last cleared on the other side--//
+                unsigned int j = block + k;
 
-                    temp_index = crest_index[k];
-                    crest_index[k] = crest_index[k+1];
-                    crest_index[k+1] = temp_index;
+                while((signal[j-1] >= level) == (side == 1))
+                {
+                    j--;
                 }
-            }
 
-            //--Delete all but the highest signal crest that exist between the current pair of adjacent ref_sig crests--//
-            for(unsigned int m=0; m<crest_index.size()-1; m++)
-            {
-                for(unsigned int n=0; n<signal_crest_time.size(); n++)
+                const double crossing = time[j-1] + (level - signal[j-1])/(signal[j] - signal[j-1]) * (time[j] - time[j-1]);
+
+                if(side == 1)
                 {
-                    if(signal_crest_time[n] == multiple_crests_time[m])
-                    {
-                        //--Delete both the non-highest signal crest and it's time, in the respective vectors--//
-                        signal_crest.erase(signal_crest.begin() + n);
-                        signal_crest_time.erase(signal_crest_time.begin() + n);
-
-                        if(signal_crest.size() != signal_crest_time.size())
-                        {
-                            cout << endl << endl << " ERROR: SIZE OF signal_crest and signal_crest_time DO NOT MATCH." << endl;
-                            exit(0);
-                        }
-                        break;
-                    }
+                    rising_crossing.push_back(crossing);
+                }
+                else
+                {
+                    falling_crossing.push_back(crossing);
                 }
             }
+
+            state = side;
+            unvisited = k+1 < CROSSING_BLOCK ? ~0ull << (k+1) : 0;
         }
     }
+}
 
-    //--Save filtered crest data in file.
-    fstream outputFile;
-    stringstream ss;
 
-    ss << "../Output/S" << signal_id << "_filtered_crest.dat";
-    outputFile.open(ss.str().c_str(), ios::out);
+// void filter_signal_crest(const Signal_Analyzer&) method
 
-    for(unsigned int i=0; i<signal_crest.size(); i++)
+/// This method filters the crests vector of the signal.
+/// It does so by retaining the highest crest that lies between two concurrent crests of the reference signal.
+/// The reference signal must come from the same file, so that both signals share the same sample indices.
+/// @param ref_sig A SignalAnalyzer object used as a reference to filter the crests of the signal.
+
+void Signal_Analyzer::filter_signal_crest(const Signal_Analyzer& ref_sig)
+{
+    Trace_Span span("filter_signal_crest", "filter", signal_id, ref_sig.get_signal_id());
+
+    vector<bool> removed(signal_crest_index.size(), false);
+
+    //--Weeding out noisy signal crest by selecting the highest signal crest between two reference signal ref_sig's crests--//
+    for(unsigned int i=0; i+1<ref_sig.get_crest_time_size(); i++)
+    {
+        const unsigned int period_start = ref_sig.get_crest_index(i);
+        const unsigned int period_end = ref_sig.get_crest_index(i+1);
+
+        unsigned int highest = signal_crest_index.size();
+
+        //--Visit all the signal crests between two concurrent ref_sig crests, and retain only the first of the highest--//
+        unsigned int j = lower_bound(signal_crest_index.begin(), signal_crest_index.end(), period_start) - signal_crest_index.begin();
+        for(; j<signal_crest_index.size() && signal_crest_index[j] <= period_end; j++)
+        {
+            if(removed[j])
+            {
+                continue;
+            }
+
+            if(highest == signal_crest_index.size())
+            {
+                highest = j;
+            }
+            else if(sample_value(signal_crest_index[j]) > sample_value(signal_crest_index[highest]))
+            {
+                removed[highest] = true;
+                highest = j;
+            }
+            else
+            {
+                removed[j] = true;
+            }
+        }
+    }
+
+    //--Delete the non-highest signal crests--//
+    unsigned int kept = 0;
+    for(unsigned int j=0; j<signal_crest_index.size(); j++)
     {
-        outputFile << signal_crest_time[i] << " " << signal_crest[i] << endl;
+        if(!removed[j])
+        {
+            signal_crest_index[kept++] = signal_crest_index[j];
+        }
     }
-    outputFile.close();
+    signal_crest_index.resize(kept);
+
+    reduce_extrema(signal_crest_index, statistics.crest);
+
+    //--Save filtered crest data in file.
+    save_extrema("_filtered_crest", signal_crest_index);
 }
 
 
@@ -443,86 +1252,261 @@ void Signal_Analyzer::filter_signal_crest(const Signal_Analyzer& ref_sig)
 
 /// This method filters the troughs vector of the signal.
 /// It does so by retaining the lowest trough that lies between two concurrent troughs of the reference signal.
+/// The reference signal must come from the same file, so that both signals share the same sample indices.
 /// @param ref_sig A SignalAnalyzer object used as a reference to filter the troughs of the signal.
 
 void Signal_Analyzer::filter_signal_trough(const Signal_Analyzer& ref_sig)
 {
-    double temp_time;
-    double temp_index;
+    Trace_Span span("filter_signal_trough", "filter", signal_id, ref_sig.get_signal_id());
+
+    vector<bool> removed(signal_trough_index.size(), false);
 
-    //--Weeding out noisy signal troughs, by selecting the highest signal trough between two reference signal ref_sig's troughs--//
-    for(unsigned int i=0; i<ref_sig.get_trough_time_size()-1; i++)
+    //--Weeding out noisy signal trough by selecting the lowest signal trough between two reference signal ref_sig's troughs--//
+    for(unsigned int i=0; i+1<ref_sig.get_trough_time_size(); i++)
     {
-        vector<double> multiple_troughs_time;
-        vector<unsigned int> trough_index;
+        const unsigned int period_start = ref_sig.get_trough_index(i);
+        const unsigned int period_end = ref_sig.get_trough_index(i+1);
 
-        //--Collect all the signal troughs between two concurrent ref_sig troughs--//
-        for(unsigned int j=0; j<signal_trough_time.size(); j++)
+        unsigned int lowest = signal_trough_index.size();
+
+        //--Visit all the signal troughs between two concurrent ref_sig troughs, and retain only the first of the lowest--//
+        unsigned int j = lower_bound(signal_trough_index.begin(), signal_trough_index.end(), period_start) - signal_trough_index.begin();
+        for(; j<signal_trough_index.size() && signal_trough_index[j] <= period_end; j++)
         {
-            if(ref_sig.get_trough_time(i) <= signal_trough_time[j] && signal_trough_time[j] <= ref_sig.get_trough_time(i+1))
+            if(removed[j])
             {
-                multiple_troughs_time.push_back(signal_trough_time[j]);
-                trough_index.push_back(j);
+                continue;
             }
-            else if(signal_trough_time[j] > ref_sig.get_trough_time(i+1))
+
+            if(lowest == signal_trough_index.size())
             {
-                break;
+                lowest = j;
+            }
+            else if(sample_value(signal_trough_index[j]) < sample_value(signal_trough_index[lowest]))
+            {
+                removed[lowest] = true;
+                lowest = j;
             }
+            else
+            {
+                removed[j] = true;
+            }
+        }
+    }
+
+    //--Delete the non-lowest signal troughs--//
+    unsigned int kept = 0;
+    for(unsigned int j=0; j<signal_trough_index.size(); j++)
+    {
+        if(!removed[j])
+        {
+            signal_trough_index[kept++] = signal_trough_index[j];
         }
+    }
+    signal_trough_index.resize(kept);
+
+    reduce_extrema(signal_trough_index, statistics.trough);
+
+    //--Save filtered trough data in file.
+    save_extrema("_filtered_trough", signal_trough_index);
+}
+
+
+// void filter_signal_crest(const Period_Grid&) method
+
+/// This method filters the crests vector of the signal against a period grid shared by all the signals, in one pass.
+/// The grid is shifted to the phase of the crests of the signal, so that each cell is centred on one crest, and only
+/// the first of the highest crests of each cell is retained.
+/// @param grid Period grid voted by all the signals of the file.
+
+void Signal_Analyzer::filter_signal_crest(const Period_Grid& grid)
+{
+    Trace_Span span("filter_signal_crest", "filter", signal_id);
+
+    filter_extrema(signal_crest_index, grid, CREST_BASIS);
+
+    reduce_extrema(signal_crest_index, statistics.crest);
+
+    //--Save filtered crest data in file.
+    save_extrema("_filtered_crest", signal_crest_index);
+}
+
+
+// void filter_signal_trough(const Period_Grid&) method
 
-        //--If there exists more than one signal trough between the current pair of adjacent ref_sig troughs,...
-        //--then sort them in descending order, based on the height of the signal trough--//
-        if(multiple_troughs_time.size()>1)
+/// This method filters the troughs vector of the signal against a period grid shared by all the signals, in one pass.
+/// The grid is shifted to the phase of the troughs of the signal, so that each cell is centred on one trough, and only
+/// the first of the lowest troughs of each cell is retained.
+/// @param grid Period grid voted by all the signals of the file.
+
+void Signal_Analyzer::filter_signal_trough(const Period_Grid& grid)
+{
+    Trace_Span span("filter_signal_trough", "filter", signal_id);
+
+    filter_extrema(signal_trough_index, grid, TROUGH_BASIS);
+
+    reduce_extrema(signal_trough_index, statistics.trough);
+
+    //--Save filtered trough data in file.
+    save_extrema("_filtered_trough", signal_trough_index);
+}
+
+
+// void filter_extrema(vector<unsigned int>&, const Period_Grid&, const Phase_Basis) const method
+
+/// This method retains the first of the highest crests, or lowest troughs, of each cell of the grid.
+/// The phase of the extrema on the grid is the circular mean over those clear of the cycle band, as noise wiggles
+/// near the mean and isolated spikes would otherwise pull it. The cell boundaries are then placed half a cycle away from it.
+/// @param extrema_index Sample index of each crest or trough, filtered in place.
+/// @param grid Period grid voted by all the signals of the file.
+/// @param basis Whether the extrema are crests or troughs.
+
+void Signal_Analyzer::filter_extrema(vector<unsigned int>& extrema_index, const Period_Grid& grid, const Phase_Basis basis) const
+{
+    const double sign = basis == CREST_BASIS ? 1.0 : -1.0;
+    const double band = calculate_cycle_band();
+
+    double sin_sum = 0.0;
+    double cos_sum = 0.0;
+
+    for(unsigned int j=0; j<extrema_index.size(); j++)
+    {
+        if(sign*(sample_value(extrema_index[j]) - signal_mean) > band)
         {
-            for(unsigned int k=0; k<trough_index.size()-1; k++)
-            {
-                if(signal_trough[trough_index[k]] <= signal_trough[trough_index[k+1]])
-                {
-                    temp_time = multiple_troughs_time[k];
-                    multiple_troughs_time[k] = multiple_troughs_time[k+1];
-                    multiple_troughs_time[k+1] = temp_time;
+            const double angle = 2.0*M_PI * grid.get_cycles(sample_time(extrema_index[j]));
 
-                    temp_index = trough_index[k];
-                    trough_index[k] = trough_index[k+1];
-                    trough_index[k+1] = temp_index;
-                }
+            sin_sum += sin(angle);
+            cos_sum += cos(angle);
+        }
+    }
+
+    if(sin_sum == 0.0 && cos_sum == 0.0)
+    {
+        return;
+    }
+
+    const double shift = atan2(sin_sum, cos_sum)/(2.0*M_PI) - 0.5;
+
+    //--Extrema are sorted by time, so the extrema of a cell are consecutive--//
+    unsigned int kept = 0;
+    double kept_cell = 0.0;
+
+    for(unsigned int j=0; j<extrema_index.size(); j++)
+    {
+        const double cell = floor(grid.get_cycles(sample_time(extrema_index[j])) - shift);
+
+        if(kept > 0 && cell == kept_cell)
+        {
+            if(sign*sample_value(extrema_index[j]) > sign*sample_value(extrema_index[kept-1]))
+            {
+                extrema_index[kept-1] = extrema_index[j];
             }
+        }
+        else
+        {
+            extrema_index[kept++] = extrema_index[j];
+            kept_cell = cell;
+        }
+    }
+    extrema_index.resize(kept);
+}
+
+
+// double calculate_cycle_band(void) const method
+
+/// This method returns the half width of the band around the mean that a crest or trough must clear to mark a cycle.
+/// It is a fraction CYCLE_HYSTERESIS of half the distance between the mean crest and the mean trough, so that it
+/// follows the amplitude of the signal.
+
+double Signal_Analyzer::calculate_cycle_band(void) const
+{
+    double crest_sum = 0.0;
+    double trough_sum = 0.0;
 
-            //--Delete all but the highest signal trough that exist between the current pair of adjacent ref_sig troughs--//
-            for(unsigned int m=0; m<trough_index.size()-1; m++)
+    for(unsigned int j=0; j<signal_crest_index.size(); j++)
+    {
+        crest_sum += sample_value(signal_crest_index[j]);
+    }
+
+    for(unsigned int j=0; j<signal_trough_index.size(); j++)
+    {
+        trough_sum += sample_value(signal_trough_index[j]);
+    }
+
+    if(signal_crest_index.empty() || signal_trough_index.empty())
+    {
+        return 0.0;
+    }
+
+    return CYCLE_HYSTERESIS * (crest_sum/signal_crest_index.size() - trough_sum/signal_trough_index.size())/2.0;
+}
+
+
+// void find_cycle_starts(vector<double>&) const method
+
+/// This method returns the times at which the cycles of the signal start, the marks it votes the period grid with.
+/// Crests and troughs are swept together in time order. A cycle starts at the first crest above the cycle band
+/// after a trough below it, so noise wiggles within the band mark no cycles.
+/// @param cycle_start Start time of every cycle, in time order.
+
+void Signal_Analyzer::find_cycle_starts(vector<double>& cycle_start) const
+{
+    Trace_Span span("find_cycle_starts", "filter", signal_id);
+
+    const double band = calculate_cycle_band();
+    int state = 0;              // 1 above the band, -1 below it, 0 not yet known
+
+    unsigned int c = 0;
+    unsigned int t = 0;
+
+    cycle_start.clear();
+
+    while(c < signal_crest_index.size() || t < signal_trough_index.size())
+    {
+        if(t == signal_trough_index.size() || (c < signal_crest_index.size() && signal_crest_index[c] < signal_trough_index[t]))
+        {
+            if(state != 1 && sample_value(signal_crest_index[c]) - signal_mean > band)
             {
-                for(unsigned int n=0; n<signal_trough_time.size(); n++)
+                if(state == -1)
                 {
-                    if(signal_trough_time[n] == multiple_troughs_time[m])
-                    {
-                        //--Delete both the non-highest signal trough and it's time, in the respective vectors--//
-                        signal_trough.erase(signal_trough.begin() + n);
-                        signal_trough_time.erase(signal_trough_time.begin() + n);
-
-                        if(signal_trough.size() != signal_trough_time.size())
-                        {
-                            cout << endl << endl << " ERROR: SIZE OF signal_trough and signal_trough_time DO NOT MATCH." << endl;
-                            exit(0);
-                        }
-                        break;
-                    }
+                    cycle_start.push_back(sample_time(signal_crest_index[c]));
                 }
+                state = 1;
+            }
+            c++;
+        }
+        else
+        {
+            if(state != -1 && signal_mean - sample_value(signal_trough_index[t]) > band)
+            {
+                state = -1;
             }
+            t++;
         }
     }
+}
 
-    //--Save filtered trough data in file.
-    fstream outputFile;
-    stringstream ss;
 
-    ss << "../Output/S" << signal_id << "_filtered_trough.dat";
-    outputFile.open(ss.str().c_str(), ios::out);
+// double get_cycles(const double) const method
+
+/// This method returns the number of cycles of the grid elapsed at the given time, interpolated linearly between
+/// the knots, and carried on at the local period of the first or the last knot outside them.
+/// @param t Time.
+
+double Period_Grid::get_cycles(const double t) const
+{
+    const unsigned int k = upper_bound(time.begin(), time.end(), t) - time.begin();
 
-    for(unsigned int i=0; i<signal_trough.size(); i++)
+    if(k == 0)
     {
-        outputFile << signal_trough_time[i] << " " << signal_trough[i] << endl;
+        return cycles.front() + (t - time.front())/period.front();
     }
-    outputFile.close();
+    if(k == time.size())
+    {
+        return cycles.back() + (t - time.back())/period.back();
+    }
+
+    return cycles[k-1] + (cycles[k] - cycles[k-1]) * (t - time[k-1])/(time[k] - time[k-1]);
 }
 
 
@@ -538,8 +1522,8 @@ double Signal_Analyzer::estimate_amplitude(void) const
     double trough_avg;
     double offset;
 
-    crest_avg = accumulate(signal_crest.begin(), signal_crest.end(), 0.0)/signal_crest.size();
-    trough_avg = accumulate(signal_trough.begin(), signal_trough.end(), 0.0)/signal_trough.size();
+    crest_avg = statistics.crest.sum/statistics.crest.count;
+    trough_avg = statistics.trough.sum/statistics.trough.count;
 
     offset = (crest_avg+trough_avg)/2.0;
     amplitude_avg = crest_avg - offset;
@@ -559,8 +1543,8 @@ double Signal_Analyzer::estimate_offset(void) const
     double crest_avg;
     double trough_avg;
 
-    crest_avg = accumulate(signal_crest.begin(), signal_crest.end(), 0.0)/signal_crest.size();
-    trough_avg = accumulate(signal_trough.begin(), signal_trough.end(), 0.0)/signal_trough.size();
+    crest_avg = statistics.crest.sum/statistics.crest.count;
+    trough_avg = statistics.trough.sum/statistics.trough.count;
 
     offset_avg = (crest_avg+trough_avg)/2.0;
 
@@ -577,28 +1561,8 @@ double Signal_Analyzer::estimate_offset(void) const
 
 double Signal_Analyzer::estimate_frequency(void) const
 {
-    vector<double> freqVec;
-    double period;
-    double freq_avg;
-
-    //--Estimate frequenct based on crests--//
-    for(unsigned int i=1; i<signal_crest_time.size(); i++)
-    {
-        //--frequency = 1.0/period--//
-        period = signal_crest_time[i] - signal_crest_time[i-1];
-        freqVec.push_back(1.0/period);
-    }
-
-    //--Estimate frequenct based on trough--//
-    for(unsigned int i=1; i<signal_trough_time.size(); i++)
-    {
-        //--frequency = 1.0/period--//
-        period = signal_trough_time[i] - signal_trough_time[i-1];
-        freqVec.push_back(1.0/period);
-    }
-
-    freq_avg = accumulate(freqVec.begin(), freqVec.end(), 0.0)/freqVec.size();
-    return (freq_avg);
+    return (statistics.crest.frequency_sum + statistics.trough.frequency_sum)
+           /(statistics.crest.no_periods + statistics.trough.no_periods);
 }
 
 
@@ -611,20 +1575,7 @@ double Signal_Analyzer::estimate_frequency(void) const
 
 double Signal_Analyzer::estimate_frequency_crest(void) const
 {
-    vector<double> freqVec;
-    double period;
-    double freq_avg;
-
-    //--Estimate frequenct based on crests--//
-    for(unsigned int i=1; i<signal_crest_time.size(); i++)
-    {
-        //--frequency = 1.0/period--//
-        period = signal_crest_time[i] - signal_crest_time[i-1];
-        freqVec.push_back(1.0/period);
-    }
-
-    freq_avg = accumulate(freqVec.begin(), freqVec.end(), 0.0)/freqVec.size();
-    return (freq_avg);
+    return statistics.crest.frequency_sum/statistics.crest.no_periods;
 }
 
 
@@ -637,20 +1588,34 @@ double Signal_Analyzer::estimate_frequency_crest(void) const
 
 double Signal_Analyzer::estimate_frequency_trough(void) const
 {
-    vector<double> freqVec;
-    double period;
-    double freq_avg;
+    return statistics.trough.frequency_sum/statistics.trough.no_periods;
+}
+
 
-    //--Estimate frequenct based on trough--//
-    for(unsigned int i=1; i<signal_trough_time.size(); i++)
+// double estimate_frequency_crossing(void) method
+
+/// This method returns an estimate of the average frequency of the signal.
+/// It does so by first estimating the period between every concurrent pair of rising crossings, and of falling crossings.
+/// Frequency = 1.0/Period
+/// Finally returns average of the calculated frequencies.
+
+double Signal_Analyzer::estimate_frequency_crossing(void) const
+{
+    double frequency_sum = 0.0;
+    double compensation = 0.0;
+    unsigned int no_periods = 0;
+
+    for(unsigned int i=1; i<rising_crossing.size(); i++, no_periods++)
     {
-        //--frequency = 1.0/period--//
-        period = signal_trough_time[i] - signal_trough_time[i-1];
-        freqVec.push_back(1.0/period);
+        compensated_add(frequency_sum, compensation, 1.0/(rising_crossing[i] - rising_crossing[i-1]));
     }
 
-    freq_avg = accumulate(freqVec.begin(), freqVec.end(), 0.0)/freqVec.size();
-    return (freq_avg);
+    for(unsigned int i=1; i<falling_crossing.size(); i++, no_periods++)
+    {
+        compensated_add(frequency_sum, compensation, 1.0/(falling_crossing[i] - falling_crossing[i-1]));
+    }
+
+    return (frequency_sum + compensation)/no_periods;
 }
 
 
@@ -679,14 +1644,16 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_crest(const Signal_Anal
     bool phase_flag;
 
     //--Calculating phase based on Crest values--//
-    for(unsigned int i=0; i<signal_crest_time.size(); i++)
+    for(unsigned int i=0; i<signal_crest_index.size(); i++)
     {
+        const double crest_time = sample_time(signal_crest_index[i]);
+
         phase_flag = false;
 
         //--Search for the two reference signal ref_sig's crests, sandwitching the current signal crest--//
         for(unsigned int j=1; j<ref_sig.get_crest_time_size(); j++)
         {
-            if(ref_sig.get_crest_time(j-1) <= signal_crest_time[i] && signal_crest_time[i] < ref_sig.get_crest_time(j))
+            if(ref_sig.get_crest_time(j-1) <= crest_time && crest_time < ref_sig.get_crest_time(j))
             {
                 period_start_time = ref_sig.get_crest_time(j-1);
                 period_end_time = ref_sig.get_crest_time(j);
@@ -698,7 +1665,7 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_crest(const Signal_Anal
 
         if(phase_flag)
         {
-            phase_360 = (signal_crest_time[i]-period_start_time)/(period_end_time-period_start_time) * 360.0;
+            phase_360 = (crest_time-period_start_time)/(period_end_time-period_start_time) * 360.0;
 
             if(phase_360 > 180.0)
             {
@@ -709,7 +1676,7 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_crest(const Signal_Anal
                 phase_180 = phase_360;
             }
 
-            phase_individual[0] = signal_crest_time[i];
+            phase_individual[0] = crest_time;
             phase_individual[1] = phase_180;
             phase_individual[2] = phase_360;
 
@@ -746,14 +1713,16 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_trough(const Signal_Ana
     bool phase_flag;
 
     //--Calculating phase based on Trough values--//
-    for(unsigned int i=0; i<signal_trough_time.size(); i++)
+    for(unsigned int i=0; i<signal_trough_index.size(); i++)
     {
+        const double trough_time = sample_time(signal_trough_index[i]);
+
         phase_flag = false;
 
         //--Search for the two reference signal ref_sig's troughs, sandwitching the current signal trough--//
         for(unsigned int j=1; j<ref_sig.get_trough_time_size(); j++)
         {
-            if(ref_sig.get_trough_time(j-1) <= signal_trough_time[i] && signal_trough_time[i] < ref_sig.get_trough_time(j))
+            if(ref_sig.get_trough_time(j-1) <= trough_time && trough_time < ref_sig.get_trough_time(j))
             {
                 period_start_time = ref_sig.get_trough_time(j-1);
                 period_end_time = ref_sig.get_trough_time(j);
@@ -765,7 +1734,7 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_trough(const Signal_Ana
 
         if(phase_flag)
         {
-            phase_360 = (signal_trough_time[i]-period_start_time)/(period_end_time-period_start_time) * 360.0;
+            phase_360 = (trough_time-period_start_time)/(period_end_time-period_start_time) * 360.0;
 
             if(phase_360 > 180.0)
             {
@@ -776,7 +1745,7 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_trough(const Signal_Ana
                 phase_180 = phase_360;
             }
 
-            phase_individual[0] = signal_trough_time[i];
+            phase_individual[0] = trough_time;
             phase_individual[1] = phase_180;
             phase_individual[2] = phase_360;
 
@@ -788,67 +1757,485 @@ vector<vector<double> > Signal_Analyzer::calculate_phase_trough(const Signal_Ana
 }
 
 
+// vector<vector<double> > calculate_phase_crossing(const Signal_Analyzer&) method
+
+/// This method returns the phase difference between the signal and the reference signal, calculated based on the
+/// crossings of the signal mean. Rising crossings are measured against the rising crossings of the reference signal,
+/// and falling crossings against its falling crossings, which gives two phase values per period.
+/// The format is that of calculate_phase_crest(), in time order.
+/// @param ref_sig A SignalAnalyzer object used as reference to calculate the signal's phase W.R.T the reference signal.
+
+vector<vector<double> > Signal_Analyzer::calculate_phase_crossing(const Signal_Analyzer& ref_sig) const
+{
+    vector<vector<double> > phase;
+
+    add_crossing_phases(rising_crossing, ref_sig.get_crossing_times(true), phase);
+    const unsigned int no_rising = phase.size();
+    add_crossing_phases(falling_crossing, ref_sig.get_crossing_times(false), phase);
+
+    //--Rows compare by time first--//
+    inplace_merge(phase.begin(), phase.begin() + no_rising, phase.end());
+
+    return phase;
+}
+
+
+// void add_crossing_phases(const vector<double>&, const vector<double>&, vector<vector<double> >&) const method
+
+/// This method appends the phase of every crossing of the signal within a period of the reference signal, the time
+/// between two concurrent reference crossings of the same direction. Both are in time order, so they are swept together.
+/// @param crossing Rising or falling crossing times of the signal.
+/// @param reference Crossing times of the reference signal, of the same direction.
+/// @param phase Phase rows to which the phase of each crossing is appended.
+
+void Signal_Analyzer::add_crossing_phases(const vector<double>& crossing, const vector<double>& reference, vector<vector<double> >& phase) const
+{
+    vector<double> phase_individual(3);
+    unsigned int j = 1;
+
+    for(unsigned int i=0; i<crossing.size(); i++)
+    {
+        //--Search for the two reference crossings sandwitching the current crossing--//
+        while(j < reference.size() && reference[j] <= crossing[i])
+        {
+            j++;
+        }
+
+        if(j < reference.size() && reference[j-1] <= crossing[i])
+        {
+            const double phase_360 = (crossing[i]-reference[j-1])/(reference[j]-reference[j-1]) * 360.0;
+
+            phase_individual[0] = crossing[i];
+            phase_individual[1] = phase_360 > 180.0 ? phase_360-360.0 : phase_360;
+            phase_individual[2] = phase_360;
+
+            phase.push_back(phase_individual);
+        }
+    }
+}
+
+
+// vector<vector<double> > calculate_phase(const Signal_Analyzer&, const Phase_Basis) method
+
+/// This method returns the phase difference between the signal and the reference signal, calculated based on
+/// signal crests, troughs or crossings. The format is that of calculate_phase_crest() and calculate_phase_trough().
+/// @param ref_sig A SignalAnalyzer object used as reference to calculate the signal's phase W.R.T the reference signal.
+/// @param basis Whether the phase is calculated based on crests, troughs or crossings.
+
+vector<vector<double> > Signal_Analyzer::calculate_phase(const Signal_Analyzer& ref_sig, const Phase_Basis basis) const
+{
+    static const char* const span_names[] = {"calculate_phase_crest", "calculate_phase_trough", "calculate_phase_crossing"};
+
+    Trace_Span span(span_names[basis], "phase", signal_id, ref_sig.get_signal_id());
+
+    if(basis == CREST_BASIS)
+    {
+        return calculate_phase_crest(ref_sig);
+    }
+    else if(basis == TROUGH_BASIS)
+    {
+        return calculate_phase_trough(ref_sig);
+    }
+    else
+    {
+        return calculate_phase_crossing(ref_sig);
+    }
+}
+
+
+// Cycle_Series calculate_cycle_series(void) const method
+
+/// This method returns the amplitude, offset and frequency of every crest-trough-crest cycle of the signal.
+/// The crests and troughs are merged in time order in a single sweep, each one updating the series in O(1).
+
+Cycle_Series Signal_Analyzer::calculate_cycle_series(void) const
+{
+    Trace_Span span("calculate_cycle_series", "cycles", signal_id);
+
+    Cycle_Series series;
+
+    unsigned int c = 0;
+    unsigned int t = 0;
+
+    while(c < signal_crest_index.size() || t < signal_trough_index.size())
+    {
+        if(t >= signal_trough_index.size() || (c < signal_crest_index.size() && signal_crest_index[c] < signal_trough_index[t]))
+        {
+            series.add_crest(sample_time(signal_crest_index[c]), sample_value(signal_crest_index[c]));
+            c++;
+        }
+        else
+        {
+            series.add_trough(sample_time(signal_trough_index[t]), sample_value(signal_trough_index[t]));
+            t++;
+        }
+    }
+
+    return series;
+}
+
+
+// void save_envelope(const double, const double, const unsigned int) const method
+
+/// This method saves a plot-ready envelope of the signal over the time window [t0,t1], to the file S<id>_envelope.
+/// The window is split into a number of equal buckets, one per pixel of the plot, and each row holds the time of
+/// the first sample of a bucket, and the minimum and maximum of the signal within the bucket.
+/// Minima and maxima are read from the min/max pyramid, so the cost depends on the width, not on the window length.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+/// @param width Number of buckets, usually the width of the plot in pixels.
+
+void Signal_Analyzer::save_envelope(const double t0, const double t1, const unsigned int width) const
+{
+    Trace_Span span("save_envelope", "output", signal_id);
+
+    if(samples_released)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
+             << "void save_envelope(const double, const double, const unsigned int) const method" << endl
+             << "Samples of Signal_" << signal_id << " have been released" << endl;
+
+        exit(1);
+    }
+
+    stringstream ss;
+    ss << "../Output/S" << signal_id << "_envelope";
+
+    Series_Writer outputFile(ss.str(), output_format, 2, get_sample_step());
+    vector<double> row(2);
+
+    const unsigned int begin = time.find_index(t0);
+    unsigned int end = time.find_index(t1);
+
+    //--Include a sample lying exactly at t1--//
+    if(end < time.size() && time[end] <= t1)
+    {
+        end++;
+    }
+
+    for(unsigned int w=0; w<width && begin<end; w++)
+    {
+        const unsigned int bucket_begin = begin + (unsigned long)(end - begin)*w/width;
+        const unsigned int bucket_end = begin + (unsigned long)(end - begin)*(w + 1)/width;
+        sample_type bucket_min;
+        sample_type bucket_max;
+
+        if(bucket_begin == bucket_end)
+        {
+            continue;
+        }
+
+        pyramid.range_min_max(signal, bucket_begin, bucket_end, bucket_min, bucket_max);
+
+        row[0] = bucket_min;
+        row[1] = bucket_max;
+        outputFile.write_row(time[bucket_begin], row);
+    }
+    outputFile.close();
+}
+
+
 // double get_crest_time(const unsigned int) method
 
-/// This method returns a single value of the crest time vector.
-/// @param i Index of crest time vector.
+/// This method returns the time of a single crest of the signal.
+/// @param i Index of crest vector.
 
 double Signal_Analyzer::get_crest_time(const unsigned int i) const
 {
-    if(i >= signal_crest_time.size())
+    return sample_time(get_crest_index(i));
+}
+
+
+// unsigned int get_crest_index(const unsigned int) method
+
+/// This method returns the sample index of a single crest of the signal.
+/// @param i Index of crest vector.
+
+unsigned int Signal_Analyzer::get_crest_index(const unsigned int i) const
+{
+    if(i >= signal_crest_index.size())
     {
         cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
-             << "double get_crest_time(const unsigned int) method" << endl
-             << i << " should be < signal_crest_time.size(): "<< signal_crest_time.size()  << endl;
+             << "unsigned int get_crest_index(const unsigned int) method" << endl
+             << i << " should be < signal_crest_index.size(): "<< signal_crest_index.size()  << endl;
 
         exit(1);
     }
     else
     {
-        return signal_crest_time[i];
+        return signal_crest_index[i];
     }
 }
 
 
 // double get_trough_time(const unsigned int) method
 
-/// This method returns a single value of the trough time vector.
-/// @param i Index of trough time vector.
+/// This method returns the time of a single trough of the signal.
+/// @param i Index of trough vector.
 
 double Signal_Analyzer::get_trough_time(const unsigned int i) const
 {
-    if(i >= signal_trough_time.size())
+    return sample_time(get_trough_index(i));
+}
+
+
+// unsigned int get_trough_index(const unsigned int) method
+
+/// This method returns the sample index of a single trough of the signal.
+/// @param i Index of trough vector.
+
+unsigned int Signal_Analyzer::get_trough_index(const unsigned int i) const
+{
+    if(i >= signal_trough_index.size())
     {
         cerr << "SignalAnalyzer Error: SignalAnalyzer class." << endl
-             << "double get_trough_time(const unsigned int) method" << endl
-             << i << " should be < signal_trough_time.size(): "<< signal_trough_time.size()  << endl;
+             << "unsigned int get_trough_index(const unsigned int) method" << endl
+             << i << " should be < signal_trough_index.size(): "<< signal_trough_index.size()  << endl;
 
         exit(1);
     }
     else
     {
-        return signal_trough_time[i];
+        return signal_trough_index[i];
     }
 }
 
 
+// double get_crest_value(const unsigned int) method
+
+/// This method returns the value of a single crest of the signal.
+/// @param i Index of crest vector.
+
+double Signal_Analyzer::get_crest_value(const unsigned int i) const
+{
+    return sample_value(get_crest_index(i));
+}
+
+
+// double get_trough_value(const unsigned int) method
+
+/// This method returns the value of a single trough of the signal.
+/// @param i Index of trough vector.
+
+double Signal_Analyzer::get_trough_value(const unsigned int i) const
+{
+    return sample_value(get_trough_index(i));
+}
+
+
 // unsigned int get_crest_time_size(void) method
 
-/// This method returns the size of the crest time vector.
+/// This method returns the number of crests of the signal.
 
 unsigned int Signal_Analyzer::get_crest_time_size(void) const
 {
-    return signal_crest_time.size();
+    return signal_crest_index.size();
 }
 
 
 // unsigned int get_trough_time_size(void) method
 
-/// This method returns the size of the trough time vector.
+/// This method returns the number of troughs of the signal.
 
 unsigned int Signal_Analyzer::get_trough_time_size(void) const
 {
-    return signal_trough_time.size();
+    return signal_trough_index.size();
+}
+
+
+// const vector<double>& get_crossing_times(const bool) const method
+
+/// This method returns the times of the rising or the falling crossings of the signal mean, in time order.
+/// @param rising True for the rising crossings, false for the falling ones.
+
+const vector<double>& Signal_Analyzer::get_crossing_times(const bool rising) const
+{
+    return rising ? rising_crossing : falling_crossing;
+}
+
+
+// void save_extrema(const char* const, const vector<unsigned int>&) const method
+
+/// This method saves a crest or trough series of the signal in a plottable file, named 'S<signal_id><suffix>',
+/// in the output format of the signal.
+/// @param suffix Suffix of the file name, without extension.
+/// @param extrema_index Sample index of each crest or trough.
+
+void Signal_Analyzer::save_extrema(const char* const suffix, const vector<unsigned int>& extrema_index) const
+{
+    if(!extrema_output)
+    {
+        return;
+    }
+
+    Trace_Span span("save_extrema", "output", signal_id);
+
+    stringstream ss;
+    ss << "../Output/S" << signal_id << suffix;
+
+    Series_Writer outputFile(ss.str(), output_format, 1, get_sample_step());
+    vector<double> row(1);
+
+    for(unsigned int i=0; i<extrema_index.size(); i++)
+    {
+        row[0] = sample_value(extrema_index[i]);
+        outputFile.write_row(sample_time(extrema_index[i]), row);
+    }
+    outputFile.close();
+}
+
+
+// void reduce_samples(void) method
+
+/// This method computes the sample statistics of the signal in a single pass over the signal column:
+/// sum, mean, minimum and maximum. The column is reduced in blocks of REDUCTION_BLOCK samples with
+/// REDUCTION_LANES independent accumulators, which the compiler can map onto SIMD registers. The block sums
+/// are combined with a compensated (Neumaier) sum, so the rounding error does not grow with the signal length.
+/// On a signal resumed from a checkpoint only the samples read since are reduced, on top of the saved statistics.
+
+void Signal_Analyzer::reduce_samples(void)
+{
+    const unsigned int n = signal.size();
+
+    double sum = checkpoint_statistics.sum;
+    double compensation = 0.0;
+
+    statistics.no_samples = checkpoint_statistics.no_samples + (n - reduce_position);
+    statistics.min = checkpoint_statistics.no_samples ? checkpoint_statistics.min : (n ? signal[0] : 0.0);
+    statistics.max = checkpoint_statistics.no_samples ? checkpoint_statistics.max : (n ? signal[0] : 0.0);
+
+    for(unsigned int block=reduce_position; block<n; block+=REDUCTION_BLOCK)
+    {
+        const unsigned int block_end = min(block+REDUCTION_BLOCK, n);
+
+        double lane_sum[REDUCTION_LANES];
+        sample_type lane_min[REDUCTION_LANES];
+        sample_type lane_max[REDUCTION_LANES];
+
+        for(unsigned int l=0; l<REDUCTION_LANES; l++)
+        {
+            lane_sum[l] = 0.0;
+            lane_min[l] = signal[block];
+            lane_max[l] = signal[block];
+        }
+
+        unsigned int i = block;
+        for(; i+REDUCTION_LANES<=block_end; i+=REDUCTION_LANES)
+        {
+            for(unsigned int l=0; l<REDUCTION_LANES; l++)
+            {
+                const sample_type v = signal[i+l];
+
+                lane_sum[l] += v;
+                lane_min[l] = v < lane_min[l] ? v : lane_min[l];
+                lane_max[l] = v > lane_max[l] ? v : lane_max[l];
+            }
+        }
+        for(; i<block_end; i++)
+        {
+            lane_sum[0] += signal[i];
+            lane_min[0] = signal[i] < lane_min[0] ? signal[i] : lane_min[0];
+            lane_max[0] = signal[i] > lane_max[0] ? signal[i] : lane_max[0];
+        }
+
+        //--Pairwise combination of the lanes--//
+        for(unsigned int width=REDUCTION_LANES/2; width>0; width/=2)
+        {
+            for(unsigned int l=0; l<width; l++)
+            {
+                lane_sum[l] += lane_sum[l+width];
+                lane_min[l] = min(lane_min[l], lane_min[l+width]);
+                lane_max[l] = max(lane_max[l], lane_max[l+width]);
+            }
+        }
+
+        compensated_add(sum, compensation, lane_sum[0]);
+        statistics.min = min(statistics.min, (double)lane_min[0]);
+        statistics.max = max(statistics.max, (double)lane_max[0]);
+    }
+
+    statistics.sum = sum + compensation;
+    statistics.mean = statistics.no_samples ? statistics.sum/statistics.no_samples : 0.0;
+
+    signal_mean = statistics.mean;
+}
+
+
+// void reduce_extrema(const vector<unsigned int>&, Extrema_Statistics&) const method
+
+/// This method computes the statistics of the crests or troughs of the signal in a single pass over their indices:
+/// compensated sum, minimum and maximum of the values, and count, sum, minimum and maximum of the periods between
+/// consecutive extrema, together with the compensated sum of their frequencies 1/period.
+/// @param extrema_index Sample index of each crest or trough.
+/// @param extrema_statistics Statistics to be filled.
+
+void Signal_Analyzer::reduce_extrema(const vector<unsigned int>& extrema_index, Extrema_Statistics& extrema_statistics) const
+{
+    double sum = 0.0;
+    double sum_compensation = 0.0;
+    double period_sum = 0.0;
+    double period_compensation = 0.0;
+    double frequency_sum = 0.0;
+    double frequency_compensation = 0.0;
+
+    extrema_statistics.count = extrema_index.size();
+    extrema_statistics.no_periods = 0;
+    extrema_statistics.min = 0.0;
+    extrema_statistics.max = 0.0;
+    extrema_statistics.period_min = 0.0;
+    extrema_statistics.period_max = 0.0;
+
+    double previous_time = 0.0;
+
+    for(unsigned int i=0; i<extrema_index.size(); i++)
+    {
+        const double value = sample_value(extrema_index[i]);
+        const double t = sample_time(extrema_index[i]);
+
+        compensated_add(sum, sum_compensation, value);
+
+        if(i == 0)
+        {
+            extrema_statistics.min = value;
+            extrema_statistics.max = value;
+        }
+        else
+        {
+            //--frequency = 1.0/period--//
+            const double period = t - previous_time;
+
+            compensated_add(period_sum, period_compensation, period);
+            compensated_add(frequency_sum, frequency_compensation, 1.0/period);
+
+            extrema_statistics.min = min(extrema_statistics.min, value);
+            extrema_statistics.max = max(extrema_statistics.max, value);
+
+            if(extrema_statistics.no_periods == 0)
+            {
+                extrema_statistics.period_min = period;
+                extrema_statistics.period_max = period;
+            }
+            extrema_statistics.period_min = min(extrema_statistics.period_min, period);
+            extrema_statistics.period_max = max(extrema_statistics.period_max, period);
+            extrema_statistics.no_periods++;
+        }
+
+        previous_time = t;
+    }
+
+    extrema_statistics.sum = sum + sum_compensation;
+    extrema_statistics.period_sum = period_sum + period_compensation;
+    extrema_statistics.frequency_sum = frequency_sum + frequency_compensation;
+}
+
+
+// const Signal_Statistics& get_statistics(void) const method
+
+/// This method returns the statistics of the signal, and of its current crests and troughs.
+
+const Signal_Statistics& Signal_Analyzer::get_statistics(void) const
+{
+    return statistics;
 }
 
 
@@ -860,3 +2247,114 @@ unsigned int Signal_Analyzer::get_signal_id(void) const
 {
     return signal_id;
 }
+
+
+// double get_sample_step(void) method
+
+/// This method returns the sampling step of the signal, or zero if there are fewer than two samples.
+
+double Signal_Analyzer::get_sample_step(void) const
+{
+    if(samples_released || dense_base > 0)
+    {
+        return sample_step;
+    }
+
+    return time.get_step();
+}
+
+
+// const Sliding_Median& get_prefilter(void) const method
+
+/// This method returns the pre-filter of the signal, with the number of samples it has replaced.
+
+const Sliding_Median& Signal_Analyzer::get_prefilter(void) const
+{
+    return prefilter;
+}
+
+
+// Signal_Memory get_memory_usage(void) const method
+
+/// This method returns the bytes held by the signal: its time column, samples, min/max pyramid and extrema.
+
+Signal_Memory Signal_Analyzer::get_memory_usage(void) const
+{
+    Signal_Memory memory;
+
+    memory.time = time.get_memory_usage();
+    memory.samples = signal.capacity() * sizeof(sample_type);
+    memory.pyramid = pyramid.get_memory_usage();
+    memory.extrema = detected.capacity() * sizeof(Extremum)
+                   + (sample_index.capacity() + signal_crest_index.capacity() + signal_trough_index.capacity()) * sizeof(unsigned int)
+                   + (rising_crossing.capacity() + falling_crossing.capacity()) * sizeof(double);
+
+    return memory;
+}
+
+
+// double wrap_phase_360(const double) function
+
+/// This function wraps a phase difference, in degrees, into the range [0°,360°).
+/// @param phase Phase difference in degrees.
+
+double wrap_phase_360(const double phase)
+{
+    double phase_360 = fmod(phase, 360.0);
+
+    if(phase_360 < 0.0)
+    {
+        phase_360 += 360.0;
+    }
+    if(phase_360 >= 360.0)
+    {
+        phase_360 -= 360.0;
+    }
+
+    return phase_360;
+}
+
+
+// double wrap_phase_180(const double) function
+
+/// This function wraps a phase difference, in degrees, into the range (-180°,180°].
+/// @param phase Phase difference in degrees.
+
+double wrap_phase_180(const double phase)
+{
+    const double phase_360 = wrap_phase_360(phase);
+
+    if(phase_360 > 180.0)
+    {
+        return phase_360-360.0;
+    }
+    else
+    {
+        return phase_360;
+    }
+}
+
+
+// void compensated_add(double&, double&, const double) function
+
+/// This function adds a value to a running sum, accumulating the rounding error of the addition separately
+/// (Neumaier's variant of Kahan summation). The compensated total is sum + compensation.
+/// @param sum Running sum.
+/// @param compensation Running rounding error of the sum.
+/// @param value Value to be added.
+
+void compensated_add(double& sum, double& compensation, const double value)
+{
+    const double t = sum + value;
+
+    if(fabs(sum) >= fabs(value))
+    {
+        compensation += (sum - t) + value;
+    }
+    else
+    {
+        compensation += (value - t) + sum;
+    }
+
+    sum = t;
+}
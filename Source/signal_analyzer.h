@@ -27,15 +27,136 @@
 #include <algorithm>
 //#include <cstdio>
 
+#include "series_writer.h"
+#include "time_axis.h"
+#include "cycle_series.h"
+#include "min_max_pyramid.h"
+#include "column_parser.h"
+#include "sliding_median.h"
+#include "trace_recorder.h"
+
 #define NOISE_THRESHOLD 5.0
 
+//--Samples before the resume point of the detection kept in a checkpoint, for the backward noise steps of the detector--//
+#define CHECKPOINT_TAIL 1024
+
 using namespace std;
 
+//--Storage type of the signal sample columns. Time and all accumulators remain double--//
+#ifdef SINGLE_PRECISION_SAMPLES
+typedef float sample_type;
+#else
+typedef double sample_type;
+#endif
+
+//--Signal feature on which phase difference is measured--//
+enum Phase_Basis
+{
+    CREST_BASIS,
+    TROUGH_BASIS,
+    CROSSING_BASIS      // Rising and falling crossings of the signal mean
+};
+
+//--Samples compared at once against the band edges by the crossing detector, one bit each--//
+#define CROSSING_BLOCK 64
+
+//--A crest or trough candidate found by the streaming detector--//
+struct Extremum
+{
+    unsigned int index;
+    bool crest;
+};
+
+//--How the streaming detector searches the samples for crest and trough candidates--//
+enum Detection_Mode
+{
+    FULL_DETECTION,      // Every sample is tested.
+    COARSE_DETECTION     // Only the samples of blocks whose minimum or maximum is extreme among their neighbours are tested.
+};
+
+//--Samples per block of the coarse detection. Blocks are aligned on sample indices, so that they do not depend on how the samples arrive--//
+#define COARSE_BLOCK_SIZE 32
+
+//--Period grid voted by all the signals of a file, as they share one frequency. It holds the number of cycles elapsed at
+//  a series of knots, and the local period at each, and interpolates linearly between them, so that the cells follow a
+//  period that drifts. Cell k spans the times at which get_cycles() lies within [k, k+1)--//
+struct Period_Grid
+{
+    vector<double> time;
+    vector<double> cycles;
+    vector<double> period;
+
+    double get_cycles(const double) const;
+};
+
+//--Half width of the band around the mean an extremum must clear to mark a cycle, as a fraction of half the distance
+//  between the mean crest and the mean trough--//
+#define CYCLE_HYSTERESIS 0.5
+
+//--Statistics of the crests or the troughs of a signal--//
+struct Extrema_Statistics
+{
+    unsigned int count;
+    double sum;
+    double min;
+    double max;
+
+    //--Periods between consecutive extrema--//
+    unsigned int no_periods;
+    double period_sum;
+    double period_min;
+    double period_max;
+    double frequency_sum;       // Σ 1/period
+};
+
+//--Statistics of a signal, produced by one reduction pass per array--//
+struct Signal_Statistics
+{
+    unsigned int no_samples;
+    double sum;
+    double mean;
+    double min;
+    double max;
+
+    Extrema_Statistics crest;
+    Extrema_Statistics trough;
+};
+
+//--Bytes held by a signal, by what holds them--//
+struct Signal_Memory
+{
+    unsigned long time;         // Explicit time column
+    unsigned long samples;
+    unsigned long pyramid;
+    unsigned long extrema;      // Candidates, crests, troughs, crossings, and the sample indices kept once the samples are released
+};
+
+#define REDUCTION_BLOCK 4096
+#define REDUCTION_LANES 8
+
+void compensated_add(double&, double&, const double);
+
+double wrap_phase_360(const double);
+double wrap_phase_180(const double);
+
 class Signal_Analyzer
 {
 public:
-    Signal_Analyzer(const char* const, const unsigned int);
+    Signal_Analyzer(const char* const, const unsigned int, const Output_Format = TEXT_OUTPUT);
+    Signal_Analyzer(const unsigned int, const Output_Format = TEXT_OUTPUT);
     void extract_signal_data_from_file(const char* const);
+    void append_samples(const vector<double>&, const vector<sample_type>&);
+    void reserve_samples(const unsigned int);
+    void set_prefilter(const Prefilter_Options&);
+    void set_extrema_output(const bool);
+    void set_detection_mode(const Detection_Mode);
+    void set_crossing_detection(const bool);
+
+    void save_checkpoint(ostream&) const;
+    void load_checkpoint(istream&);
+    void save_extrema_state(ostream&) const;
+    void load_extrema_state(istream&);
+    void release_samples(void);
     void crop_length(const double, const double);
 
     bool is_previous_signal_lower(const unsigned int) const;
@@ -44,8 +165,15 @@ public:
     void select_signal_crest(void);
     void select_signal_trough(void);
 
+    void detect_candidates(vector<Extremum>&);
+    void finish_detection(const vector<Extremum>&);
+
     void filter_signal_crest(const Signal_Analyzer&);
     void filter_signal_trough(const Signal_Analyzer&);
+    void filter_signal_crest(const Period_Grid&);
+    void filter_signal_trough(const Period_Grid&);
+
+    void find_cycle_starts(vector<double>&) const;
 
     double estimate_amplitude(void) const;
     double estimate_offset(void) const;
@@ -53,30 +181,150 @@ public:
     double estimate_frequency(void) const;
     double estimate_frequency_crest(void) const;
     double estimate_frequency_trough(void) const;
+    double estimate_frequency_crossing(void) const;
 
     vector<vector<double> > calculate_phase_crest(const Signal_Analyzer&) const;
     vector<vector<double> > calculate_phase_trough(const Signal_Analyzer&) const;
+    vector<vector<double> > calculate_phase_crossing(const Signal_Analyzer&) const;
+    vector<vector<double> > calculate_phase(const Signal_Analyzer&, const Phase_Basis) const;
+
+    Cycle_Series calculate_cycle_series(void) const;
+
+    void save_envelope(const double, const double, const unsigned int) const;
 
     double get_crest_time(const unsigned int) const;
     double get_trough_time(const unsigned int) const;
 
+    unsigned int get_crest_index(const unsigned int) const;
+    unsigned int get_trough_index(const unsigned int) const;
+
+    double get_crest_value(const unsigned int) const;
+    double get_trough_value(const unsigned int) const;
+
     unsigned int get_crest_time_size(void) const;
     unsigned int get_trough_time_size(void) const;
 
+    const vector<double>& get_crossing_times(const bool) const;
+
     unsigned int get_signal_id(void) const;
+    const Signal_Statistics& get_statistics(void) const;
+    double get_sample_step(void) const;
+    const Sliding_Median& get_prefilter(void) const;
+    Signal_Memory get_memory_usage(void) const;
 
 private:
+    bool is_crest_candidate(const unsigned int) const;
+    bool is_trough_candidate(const unsigned int) const;
+    void scan_candidates(const unsigned int, const bool, vector<Extremum>&);
+    void scan_blocks(const unsigned int, const bool, vector<Extremum>&);
+    void find_block_extremes(const unsigned int, const unsigned int, sample_type&, sample_type&) const;
+
+    void detect_crossings(void);
+    void add_crossing_phases(const vector<double>&, const vector<double>&, vector<vector<double> >&) const;
+
+    void save_extrema(const char* const, const vector<unsigned int>&) const;
+
+    double calculate_cycle_band(void) const;
+    void filter_extrema(vector<unsigned int>&, const Period_Grid&, const Phase_Basis) const;
+
+    unsigned int sample_position(const unsigned int) const;
+    double sample_time(const unsigned int) const;
+    double sample_value(const unsigned int) const;
+
+    void reduce_samples(void);
+    void reduce_extrema(const vector<unsigned int>&, Extrema_Statistics&) const;
+
     unsigned int signal_id;
     double signal_mean;
 
-    vector<double> time;
-    vector<double> signal;
+    Output_Format output_format;
+    bool extrema_output;
+
+    Detection_Mode detection_mode;
+    unsigned int detect_position;
+
+    Signal_Statistics statistics;
+
+    Time_Axis time;
+    vector<sample_type> signal;
+
+    //--Median or Hampel filter applied in place as samples are appended. The last get_delay() samples are not yet final--//
+    Sliding_Median prefilter;
+
+    //--Block minima and maxima of the signal, built during ingest for plotting--//
+    Min_Max_Pyramid<sample_type> pyramid;
+
+    //--Samples below the sample index dense_base are held only if listed in sample_index. Once the samples are released,
+    //  time and signal hold only the extrema. A signal resumed from a checkpoint holds the earlier candidates, and then
+    //  every sample from dense_base on--//
+    bool samples_released;
+    double sample_step;
+    vector<unsigned int> sample_index;
+    unsigned int dense_base;
+
+    //--Sampling grid of a signal resumed from a checkpoint, so that appended samples get the times a single run gives them--//
+    bool grid_uniform;
+    double grid_t0;
+    double grid_dt;
+
+    //--Statistics of the samples read before a checkpoint, which reduce_samples() extends from reduce_position on--//
+    Signal_Statistics checkpoint_statistics;
+    unsigned int reduce_position;
 
-    vector<double> signal_crest;
-    vector<double> signal_crest_time;
+    //--Every crest and trough candidate found so far, and how many of them were final when the detection finished--//
+    vector<Extremum> detected;
+    unsigned int no_final_detected;
+    unsigned int checkpoint_position;
 
-    vector<double> signal_trough;
-    vector<double> signal_trough_time;
+    //--Crests and troughs are held as sample indices into time and signal--//
+    vector<unsigned int> signal_crest_index;
+    vector<unsigned int> signal_trough_index;
+
+    //--Interpolated times of the crossings of the signal mean, found only if crossing_detection is set--//
+    bool crossing_detection;
+    vector<double> rising_crossing;
+    vector<double> falling_crossing;
 };
 
+
+
+// unsigned int sample_position(const unsigned int) const method
+
+/// This method returns the position, in time and signal, of the sample with the given sample index.
+/// Before the samples are released the two are the same. Afterwards only extrema can be looked up.
+/// On a signal resumed from a checkpoint, only the earlier candidates and the samples from dense_base on.
+/// @param index Sample index.
+
+inline unsigned int Signal_Analyzer::sample_position(const unsigned int index) const
+{
+    if(index >= dense_base)
+    {
+        return sample_index.size() + (index - dense_base);
+    }
+
+    return lower_bound(sample_index.begin(), sample_index.end(), index) - sample_index.begin();
+}
+
+
+// double sample_time(const unsigned int) const method
+
+/// This method returns the time of a sample.
+/// @param index Sample index.
+
+inline double Signal_Analyzer::sample_time(const unsigned int index) const
+{
+    return time[sample_position(index)];
+}
+
+
+// double sample_value(const unsigned int) const method
+
+/// This method returns the value of a sample.
+/// @param index Sample index.
+
+inline double Signal_Analyzer::sample_value(const unsigned int index) const
+{
+    return signal[sample_position(index)];
+}
+
 #endif // SIGNAL_ANALYZER_H
@@ -14,6 +14,7 @@
 /********************************************************************************************/
 
 #include"signal_analyzer_list.h"
+#include"signal_pipeline.h"
 
 // CONSTRUCTOR
 
@@ -22,11 +23,16 @@
 /// Creates and adds to the list, the necessary numbe of Signal Analyzer objects.
 /// Removes pre-existing output files.
 /// @param signalsFileName Path and name of the file containing signals data.
+/// @param options Whether the signals are read sequentially or through the ingest pipeline, and under which memory budget.
+/// @param format Format of the output files, text or binary.
 
-Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName)
+Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName, const Ingest_Options& options, const Output_Format format)
 {
-    //--Remove old output files--//
-    system("exec rm -r ../Output/*");
+    phase_mode = ALL_PAIRS_PHASE;
+    filter_mode = PAIRWISE_FILTER;
+    output_format = format;
+
+    remove_output_files();
 
     if(!signalsFileName)
     {
@@ -43,12 +49,13 @@ Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName)
         exit(1);
     }
 
-    //--Create a Signal Analyzer object per signal and add to the list--//
+    vector<unsigned int> signalIDList;
     for(unsigned int i=0; i<no_of_signals; i++)
     {
-        Signal_Analyzer s_an(signalsFileName, i+1);
-        S.push_back(s_an);
+        signalIDList.push_back(i+1);
     }
+
+    load_signals(signalsFileName, signalIDList, options);
 }
 
 
@@ -60,11 +67,16 @@ Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName)
 /// Removes pre-existing output files.
 /// @param signalsFileName Path and name of the file containing signals data.
 /// @param signalIDList A vector containing the IDs of the signals to be extracted from the file.
+/// @param options Whether the signals are read sequentially or through the ingest pipeline, and under which memory budget.
+/// @param format Format of the output files, text or binary.
 
-Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName, const vector<unsigned int>& signalIDList)
+Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName, const vector<unsigned int>& signalIDList, const Ingest_Options& options, const Output_Format format)
 {
-    //--Remove old output files--//
-    system("exec rm -r ../Output/*");
+    phase_mode = ALL_PAIRS_PHASE;
+    filter_mode = PAIRWISE_FILTER;
+    output_format = format;
+
+    remove_output_files();
 
     if(!signalsFileName)
     {
@@ -81,12 +93,783 @@ Signal_Analyzer_List::Signal_Analyzer_List(const char* signalsFileName, const ve
         exit(1);
     }
 
+    load_signals(signalsFileName, signalIDList, options);
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a Signal Analyzer List object
+/// The signals are restored from the state written by save_extrema_state(), instead of being read from a data file.
+/// Removes pre-existing output files.
+/// @param stateFile Stream holding the saved state of the signals.
+/// @param options Whether the crests and troughs are saved in file, and whether the crossings are used.
+/// @param format Format of the output files, text or binary.
+
+Signal_Analyzer_List::Signal_Analyzer_List(istream& stateFile, const Ingest_Options& options, const Output_Format format)
+{
+    phase_mode = ALL_PAIRS_PHASE;
+    filter_mode = PAIRWISE_FILTER;
+    output_format = format;
+
+    remove_output_files();
+
+    string signals_keyword;
+    vector<unsigned int> signalIDList;
+
+    no_of_signals = 0;
+    stateFile >> signals_keyword >> no_of_signals;
+
+    for(unsigned int i=0; stateFile && i<no_of_signals; i++)
+    {
+        unsigned int id;
+
+        stateFile >> id;
+        signalIDList.push_back(id);
+    }
+
+    if(!stateFile || signals_keyword != "signals" || !no_of_signals)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "Signal_Analyzer_List(istream&, const Ingest_Options&, const Output_Format) method" << endl
+             << "No signals found in saved state" << endl;
+
+        exit(1);
+    }
+
+    S.reserve(no_of_signals);
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        S.push_back(Signal_Analyzer(signalIDList[i], output_format));
+        S.back().set_extrema_output(options.extrema_output);
+        S.back().set_detection_mode(options.detection);
+        S.back().set_crossing_detection(options.crossings);
+        S.back().load_extrema_state(stateFile);
+    }
+}
+
+
+// void remove_output_files(void) method
+
+/// This method removes the output files of a previous run.
+
+void Signal_Analyzer_List::remove_output_files(void)
+{
+    system("exec rm -r ../Output/*");
+}
+
+
+// void load_signals(const char* const, const vector<unsigned int>&, const Ingest_Options&) method
+
+/// This method creates a Signal Analyzer object per signal ID and adds it to the list.
+/// In sequential mode the file is read once, on the calling thread, and then the crests and troughs of each signal are selected.
+/// In pipelined mode the objects are filled by a Signal_Pipeline.
+/// Under a memory budget the signals are loaded in column groups, each holding about as much signal data as the budget,
+/// and the signal data of a group is released, keeping only the extrema, before the next group is read.
+/// A median or Hampel pre-filter, if set, is applied to every signal as it is read, whichever the mode.
+/// With a checkpoint, the detection state saved by the previous run is restored and only the lines appended since are read.
+/// The state is then saved again, and the signal data released as under a memory budget.
+/// With a time window, only the rows within it are read.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param signalIDList A vector containing the IDs of the signals to be extracted from the file.
+/// @param options Whether the signals are read sequentially or through the ingest pipeline, under which memory budget, from which checkpoint
+///                and within which time window.
+
+void Signal_Analyzer_List::load_signals(const char* const signalsFileName, const vector<unsigned int>& signalIDList, const Ingest_Options& options)
+{
+    unsigned int no_rows = 0;
+    unsigned int group_size = no_of_signals;
+    unsigned long no_replaced = 0;
+
+    unsigned long start_offset = 0;
+    unsigned long end_offset = ULONG_MAX;
+    vector<string> restored_state;
+    vector<string> saved_state;
+
+    if(options.checkpoint)
+    {
+        //--A line still being written by the logger is left for the next run--//
+        start_offset = read_checkpoint(options.checkpoint, signalsFileName, signalIDList, options.prefilter, options.detection, restored_state);
+        end_offset = find_end_of_lines(signalsFileName);
+
+        cout << endl << "Checkpoint: " << (restored_state.empty() ? "reading from the start, " : "resuming, ")
+             << end_offset - start_offset << " new bytes" << endl;
+    }
+
+    if(options.read_window)
+    {
+        find_time_range(signalsFileName, options.window_start, options.window_end, start_offset, end_offset);
+
+        cout << endl << "Time window: [" << options.window_start << ":" << options.window_end << "], reading from byte " << start_offset;
+        if(end_offset != ULONG_MAX)
+        {
+            cout << " to byte " << end_offset;
+        }
+        cout << endl;
+    }
+
+    if(options.memory_budget > 0)
+    {
+        //--Sample column, plus an explicit time column in case the sampling is irregular--//
+        no_rows = count_rows(signalsFileName, start_offset, end_offset);
+        const unsigned long signal_bytes = (unsigned long)no_rows * (sizeof(sample_type) + sizeof(double));
+
+        group_size = max(1ul, min((unsigned long)no_of_signals, options.memory_budget/max(1ul, signal_bytes)));
+
+        cout << endl << "Memory budget: " << options.memory_budget/(1024*1024) << " MB, reading "
+             << no_of_signals << " signals in groups of " << group_size << endl;
+    }
+
     //--Create a Signal Analyzer object per signal and add to the list--//
+    S.reserve(no_of_signals);
+
+    for(unsigned int first=0; first<no_of_signals; first+=group_size)
+    {
+        const vector<unsigned int> groupIDList(signalIDList.begin()+first, signalIDList.begin()+min(first+group_size, no_of_signals));
+        vector<Signal_Analyzer> group;
+
+        for(unsigned int i=0; i<groupIDList.size(); i++)
+        {
+            group.push_back(Signal_Analyzer(groupIDList[i], output_format));
+            group.back().set_prefilter(options.prefilter);
+            group.back().set_extrema_output(options.extrema_output);
+            group.back().set_detection_mode(options.detection);
+            group.back().set_crossing_detection(options.crossings);
+            if(!restored_state.empty())
+            {
+                istringstream state(restored_state[first+i]);
+                group.back().load_checkpoint(state);
+            }
+            if(no_rows > 0)
+            {
+                group.back().reserve_samples(no_rows);
+            }
+        }
+
+        if(options.mode == PIPELINED_INGEST)
+        {
+            Signal_Pipeline pipeline(signalsFileName, groupIDList, start_offset, end_offset);
+            pipeline.run(group);
+        }
+        else
+        {
+            read_signals(signalsFileName, groupIDList, group, start_offset, end_offset);
+
+            for(unsigned int i=0; i<group.size(); i++)
+            {
+                vector<Extremum> candidates;
+
+                group[i].detect_candidates(candidates);
+                group[i].finish_detection(candidates);
+            }
+        }
+
+        for(unsigned int i=0; i<group.size(); i++)
+        {
+            no_replaced += group[i].get_prefilter().get_no_replaced();
+
+            if(options.checkpoint)
+            {
+                ostringstream state;
+                state.precision(17);
+
+                group[i].save_checkpoint(state);
+                saved_state.push_back(state.str());
+            }
+
+            if(options.memory_budget > 0 || options.checkpoint)
+            {
+                group[i].release_samples();
+            }
+            S.push_back(std::move(group[i]));
+        }
+    }
+
+    if(options.prefilter.mode != NO_PREFILTER)
+    {
+        cout << endl << (options.prefilter.mode == MEDIAN_PREFILTER ? "Median" : "Hampel") << " pre-filter over "
+             << options.prefilter.window << " samples changed " << no_replaced << " samples" << endl;
+    }
+
+    if(options.checkpoint)
+    {
+        write_checkpoint(options.checkpoint, signalsFileName, end_offset, signalIDList, options.prefilter, options.detection, saved_state);
+    }
+}
+
+
+// void read_signals(const char* const, const vector<unsigned int>&, vector<Signal_Analyzer>&) const method
+
+/// This method reads a group of signals in a single pass over a byte range of the data file.
+/// Only the time and the columns of the given signals are converted, and the rows are appended to the
+/// Signal Analyzer objects in blocks of PIPELINE_BLOCK_SIZE rows.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param signalIDList A vector containing the IDs of the signals.
+/// @param analyzers Signal Analyzer objects, one per signal ID, in the same order as the signal IDs.
+/// @param startOffset Byte offset of the first line to be read.
+/// @param endOffset Byte offset at which reading stops, the end of a line. By default the end of the file.
+
+void Signal_Analyzer_List::read_signals(const char* const signalsFileName, const vector<unsigned int>& signalIDList, vector<Signal_Analyzer>& analyzers,
+                                        const unsigned long startOffset, const unsigned long endOffset) const
+{
+    Trace_Span span("read_signals", "ingest");
+
+    fstream inputFile;
+
+    inputFile.open(signalsFileName, ios::in);
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "void read_signals(const char* const, const vector<unsigned int>&, vector<Signal_Analyzer>&, const unsigned long, const unsigned long) const method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+    inputFile.seekg(startOffset);
+
+    const unsigned int no_signals = signalIDList.size();
+
+    Column_Parser parser(signalIDList);
+    vector<double> block_time;
+    vector<vector<sample_type> > block_signal(no_signals);
+    vector<double> values;
+
+    string line;
+    double t;
+    bool last = false;
+    unsigned long offset = startOffset;
+
+    while(!last)
+    {
+        last = offset >= endOffset || !getline(inputFile, line);
+        if(!last)
+        {
+            offset += line.size() + 1;
+        }
+
+        //--Omitting lines containing '#', and empty lines--//
+        if(!last && parser.parse_line(line, t, values))
+        {
+            block_time.push_back(t);
+            for(unsigned int i=0; i<no_signals; i++)
+            {
+                block_signal[i].push_back(values[i]);
+            }
+        }
+
+        if(block_time.size() == PIPELINE_BLOCK_SIZE || (last && !block_time.empty()))
+        {
+            for(unsigned int i=0; i<no_signals; i++)
+            {
+                analyzers[i].append_samples(block_time, block_signal[i]);
+                block_signal[i].clear();
+            }
+            block_time.clear();
+        }
+    }
+    inputFile.close();
+}
+
+
+// unsigned int count_rows(const char* const) const method
+
+/// This method returns the number of data rows within a byte range of the data file, omitting lines containing '#' and empty lines.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param startOffset Byte offset of the first line to be counted.
+/// @param endOffset Byte offset at which counting stops, the end of a line. By default the end of the file.
+
+unsigned int Signal_Analyzer_List::count_rows(const char* const signalsFileName, const unsigned long startOffset, const unsigned long endOffset) const
+{
+    Trace_Span span("count_rows", "ingest");
+
+    fstream inputFile;
+
+    inputFile.open(signalsFileName, ios::in);
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "unsigned int count_rows(const char* const, const unsigned long, const unsigned long) const method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+    inputFile.seekg(startOffset);
+
+    Column_Parser parser((vector<unsigned int>()));
+    vector<double> values;
+    string line;
+    double t;
+    unsigned int no_rows = 0;
+    unsigned long offset = startOffset;
+
+    while(offset < endOffset && getline(inputFile, line))
+    {
+        offset += line.size() + 1;
+
+        if(parser.parse_line(line, t, values))
+        {
+            no_rows++;
+        }
+    }
+    inputFile.close();
+
+    return no_rows;
+}
+
+
+// unsigned long read_checkpoint(const char* const, const char* const, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, vector<string>&) const method
+
+/// This method reads the checkpoint written by a previous run, and returns the byte offset of the data file it covers.
+/// The checkpoint is used only if it was written for the same signals, pre-filter and detection mode, and the file still
+/// holds the same line just before that offset, so that a file that was replaced or truncated is read again from the start.
+/// @param checkpointFileName Path and name of the checkpoint file.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param signalIDList A vector containing the IDs of the signals.
+/// @param prefilter Pre-filter of the signals.
+/// @param detection Detection mode of the signals.
+/// @param signalState Saved state of each signal, in the order of the signal IDs, or empty if the checkpoint cannot be used.
+
+unsigned long Signal_Analyzer_List::read_checkpoint(const char* const checkpointFileName, const char* const signalsFileName, const vector<unsigned int>& signalIDList,
+                                                    const Prefilter_Options& prefilter, const Detection_Mode detection, vector<string>& signalState) const
+{
+    signalState.clear();
+
+    fstream checkpointFile;
+    checkpointFile.open(checkpointFileName, ios::in);
+
+    if(!checkpointFile.is_open())
+    {
+        //--First run--//
+        return 0;
+    }
+
+    string comment, offset_keyword, line_keyword, signals_keyword, prefilter_keyword, detection_keyword;
+    unsigned long offset = 0;
+    string last_line;
+    unsigned int no_signals = 0;
+    vector<unsigned int> ids;
+    unsigned int mode = 0;
+    unsigned int window = 0;
+    double threshold = 0.0;
+    unsigned int detection_mode = 0;
+
+    getline(checkpointFile, comment);
+    checkpointFile >> offset_keyword >> offset >> line_keyword;
+    checkpointFile.get();
+    getline(checkpointFile, last_line);
+    checkpointFile >> signals_keyword >> no_signals;
+
+    for(unsigned int i=0; checkpointFile && i<no_signals; i++)
+    {
+        unsigned int id;
+        checkpointFile >> id;
+        ids.push_back(id);
+    }
+    checkpointFile >> prefilter_keyword >> mode >> window >> threshold >> detection_keyword >> detection_mode;
+
+    if(!checkpointFile || offset_keyword != "offset" || line_keyword != "line" || signals_keyword != "signals" || prefilter_keyword != "prefilter")
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "unsigned long read_checkpoint(const char* const, const char* const, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, vector<string>&) const method" << endl
+             << "Malformed checkpoint file: " << checkpointFileName << endl;
+
+        exit(1);
+    }
+
+    if(ids != signalIDList || detection_keyword != "detection" || detection_mode != (unsigned int)detection || mode != (unsigned int)prefilter.mode || (mode != NO_PREFILTER && (window != prefilter.window || threshold != prefilter.threshold))
+       || find_end_of_lines(signalsFileName) < offset || read_line_before(signalsFileName, offset) != last_line)
+    {
+        cout << endl << "Checkpoint " << checkpointFileName << " does not match " << signalsFileName << endl;
+        return 0;
+    }
+
+    //--The state of each signal runs up to its 'end' line--//
+    string line;
+    getline(checkpointFile, line);
+
+    for(unsigned int i=0; i<no_signals; i++)
+    {
+        string state;
+
+        while(getline(checkpointFile, line))
+        {
+            state += line + "\n";
+            if(line == "end")
+            {
+                break;
+            }
+        }
+        signalState.push_back(state);
+    }
+    checkpointFile.close();
+
+    return offset;
+}
+
+
+// void write_checkpoint(const char* const, const char* const, const unsigned long, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, const vector<string>&) const method
+
+/// This method writes the checkpoint read by the next run. It is written to a temporary file that then replaces the
+/// previous checkpoint, so an interrupted run leaves the previous one intact.
+/// @param checkpointFileName Path and name of the checkpoint file.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param offset Byte offset of the data file up to which the signals were read.
+/// @param signalIDList A vector containing the IDs of the signals.
+/// @param prefilter Pre-filter of the signals.
+/// @param detection Detection mode of the signals.
+/// @param signalState State of each signal written by Signal_Analyzer::save_checkpoint(), in the order of the signal IDs.
+
+void Signal_Analyzer_List::write_checkpoint(const char* const checkpointFileName, const char* const signalsFileName, const unsigned long offset,
+                                            const vector<unsigned int>& signalIDList, const Prefilter_Options& prefilter, const Detection_Mode detection,
+                                            const vector<string>& signalState) const
+{
+    const string temporaryFileName = string(checkpointFileName) + ".tmp";
+
+    fstream checkpointFile;
+    checkpointFile.open(temporaryFileName.c_str(), ios::out);
+
+    if(!checkpointFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "void write_checkpoint(const char* const, const char* const, const unsigned long, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, const vector<string>&) const method" << endl
+             << "Cannot open checkpoint file: " << temporaryFileName << endl;
+
+        exit(1);
+    }
+
+    checkpointFile.precision(17);
+    checkpointFile << "# SignalAnalyzer checkpoint of " << signalsFileName << endl
+                   << "offset " << offset << endl
+                   << "line " << read_line_before(signalsFileName, offset) << endl
+                   << "signals " << signalIDList.size();
+
+    for(unsigned int i=0; i<signalIDList.size(); i++)
+    {
+        checkpointFile << " " << signalIDList[i];
+    }
+    checkpointFile << endl << "prefilter " << prefilter.mode << " " << prefilter.window << " " << prefilter.threshold << endl
+                   << "detection " << detection << endl;
+
+    for(unsigned int i=0; i<signalState.size(); i++)
+    {
+        checkpointFile << signalState[i];
+    }
+    checkpointFile.close();
+
+    if(checkpointFile.fail() || rename(temporaryFileName.c_str(), checkpointFileName) != 0)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "void write_checkpoint(const char* const, const char* const, const unsigned long, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, const vector<string>&) const method" << endl
+             << "Cannot write checkpoint file: " << checkpointFileName << endl;
+
+        exit(1);
+    }
+}
+
+
+// unsigned long find_end_of_lines(const char* const) const method
+
+/// This method returns the byte offset just past the last newline of the data file, leaving out a last line that may still be being written.
+/// @param signalsFileName Path and name of the file containing signals data.
+
+unsigned long Signal_Analyzer_List::find_end_of_lines(const char* const signalsFileName) const
+{
+    fstream inputFile;
+    inputFile.open(signalsFileName, ios::in | ios::binary);
+
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "unsigned long find_end_of_lines(const char* const) const method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+
+    inputFile.seekg(0, ios::end);
+    unsigned long end = inputFile.tellg();
+
+    vector<char> buffer(CHECKPOINT_LINE_SCAN);
+
+    while(end > 0)
+    {
+        const unsigned long begin = end > buffer.size() ? end - buffer.size() : 0;
+
+        inputFile.seekg(begin);
+        inputFile.read(&buffer[0], end - begin);
+
+        for(unsigned long i=end-begin; i>0; i--)
+        {
+            if(buffer[i-1] == '\n')
+            {
+                return begin + i;
+            }
+        }
+        end = begin;
+    }
+
+    return 0;
+}
+
+
+// string read_line_before(const char* const, const unsigned long) const method
+
+/// This method returns the line of the data file that ends just before the given byte offset, or its last
+/// CHECKPOINT_LINE_SCAN bytes if it is longer.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param offset Byte offset just past a newline.
+
+string Signal_Analyzer_List::read_line_before(const char* const signalsFileName, const unsigned long offset) const
+{
+    if(offset == 0)
+    {
+        return string();
+    }
+
+    fstream inputFile;
+    inputFile.open(signalsFileName, ios::in | ios::binary);
+
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "string read_line_before(const char* const, const unsigned long) const method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+
+    //--The newline ending the line is not part of it--//
+    const unsigned long begin = offset-1 > CHECKPOINT_LINE_SCAN ? offset-1 - CHECKPOINT_LINE_SCAN : 0;
+    string text(offset-1 - begin, '\0');
+
+    inputFile.seekg(begin);
+    inputFile.read(&text[0], text.size());
+    text.resize(inputFile.gcount());
+
+    const size_t newline = text.rfind('\n');
+
+    return newline == string::npos ? text : text.substr(newline+1);
+}
+
+
+// void find_time_range(const char* const, const double, const double, unsigned long&, unsigned long&) const method
+
+/// This method finds the byte range of the data file that holds the rows with time within [start_time:end_time].
+/// As time grows down the file, both ends are found by binary search over the bytes of the memory-mapped file,
+/// so only the times of a few dozen rows are parsed, whatever the length of the file.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param start_time Time below which rows are not read.
+/// @param end_time Time above which rows are not read.
+/// @param start_offset Byte offset of the first row at or after start_time.
+/// @param end_offset Byte offset of the first row after end_time, or ULONG_MAX if there is none.
+
+void Signal_Analyzer_List::find_time_range(const char* const signalsFileName, const double start_time, const double end_time,
+                                           unsigned long& start_offset, unsigned long& end_offset) const
+{
+    const int file = open(signalsFileName, O_RDONLY);
+    struct stat file_status;
+
+    if(file < 0 || fstat(file, &file_status) != 0)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "void find_time_range(const char* const, const double, const double, unsigned long&, unsigned long&) const method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+
+    const unsigned long size = file_status.st_size;
+
+    start_offset = 0;
+    end_offset = ULONG_MAX;
+
+    if(size > 0)
+    {
+        void* const mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if(mapping == MAP_FAILED)
+        {
+            cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+                 << "void find_time_range(const char* const, const double, const double, unsigned long&, unsigned long&) const method" << endl
+                 << "Cannot map Parameter file: "<< signalsFileName  << endl;
+
+            exit(1);
+        }
+
+        const char* const data = (const char*)mapping;
+
+        //--Only whole lines are searched. A last line without a newline is read only if the window reaches it--//
+        unsigned long lines_end = size;
+        while(lines_end > 0 && data[lines_end-1] != '\n')
+        {
+            lines_end--;
+        }
+
+        start_offset = find_row_at_time(data, lines_end, start_time, false);
+
+        const unsigned long row_after = find_row_at_time(data, lines_end, end_time, true);
+        if(row_after < lines_end)
+        {
+            end_offset = row_after;
+        }
+
+        munmap(mapping, size);
+    }
+    close(file);
+}
+
+
+// unsigned long find_row_at_time(const char* const, const unsigned long, const double, const bool) const method
+
+/// This method returns the byte offset of the first row of the mapped data file with time at or after the given
+/// time, or strictly after it, or the end of the lines if there is none.
+/// @param data Mapped data file.
+/// @param end Byte offset just past the last newline of the file.
+/// @param t Time searched for.
+/// @param after True for the first row with time after t, false for the first row with time at or after t.
+
+unsigned long Signal_Analyzer_List::find_row_at_time(const char* const data, const unsigned long end, const double t, const bool after) const
+{
+    unsigned long low = 0;
+    unsigned long high = end;
+    double row_time;
+
+    //--Smallest byte offset whose next row is past t. The next row of every offset below it is not--//
+    while(low < high)
+    {
+        const unsigned long middle = low + (high-low)/2;
+        const unsigned long row = find_next_row(data, middle, end, row_time);
+
+        if(row == end || (after ? row_time > t : row_time >= t))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle+1;
+        }
+    }
+
+    return find_next_row(data, low, end, row_time);
+}
+
+
+// unsigned long find_next_row(const char* const, const unsigned long, const unsigned long, double&) const method
+
+/// This method returns the byte offset of the first row of the mapped data file starting at or after the given
+/// offset, and its time, or the end of the lines if there is none. As for Column_Parser, lines containing '#', and
+/// empty lines, are not rows.
+/// @param data Mapped data file.
+/// @param offset Byte offset the search starts at.
+/// @param end Byte offset just past the last newline of the file.
+/// @param row_time Time of the row.
+
+unsigned long Signal_Analyzer_List::find_next_row(const char* const data, const unsigned long offset, const unsigned long end, double& row_time) const
+{
+    unsigned long row = offset;
+
+    //--Start of the next line--//
+    while(row > 0 && row < end && data[row-1] != '\n')
+    {
+        row++;
+    }
+
+    while(row < end)
+    {
+        const unsigned long next = (const char*)memchr(data+row, '\n', end-row) - data + 1;
+
+        unsigned long first = row;
+        while(data[first] == ' ' || data[first] == '\t')
+        {
+            first++;
+        }
+
+        //--The time stops at the newline at the latest, once the line is known not to be blank--//
+        char* parsed;
+        if(data[first] != '\n' && data[first] != '\r' && memchr(data+row, '#', next-row) == NULL)
+        {
+            row_time = strtod(data+first, &parsed);
+            if(parsed != data+first)
+            {
+                return row;
+            }
+        }
+        row = next;
+    }
+
+    return end;
+}
+
+
+// void set_phase_mode(const Phase_Mode) method
+
+/// This method sets how the phase difference of every pair of signals is obtained.
+/// @param mode All pairs phase mode, or reference phase mode.
+
+void Signal_Analyzer_List::set_phase_mode(const Phase_Mode mode)
+{
+    phase_mode = mode;
+}
+
+
+// void set_filter_mode(const Filter_Mode) method
+
+/// This method sets how the crests and troughs of each signal are filtered against the other signals.
+/// @param mode Pairwise filter mode, or consensus filter mode.
+
+void Signal_Analyzer_List::set_filter_mode(const Filter_Mode mode)
+{
+    filter_mode = mode;
+}
+
+
+// unsigned int get_no_of_signals(void) const method
+
+/// This method returns the number of signals on the list.
+
+unsigned int Signal_Analyzer_List::get_no_of_signals(void) const
+{
+    return no_of_signals;
+}
+
+
+// const Signal_Analyzer& get_signal(const unsigned int) const method
+
+/// This method returns a signal of the list.
+/// @param i Position of the signal on the list.
+
+const Signal_Analyzer& Signal_Analyzer_List::get_signal(const unsigned int i) const
+{
+    if(i >= no_of_signals)
+    {
+        cerr << "SignalAnalyzer Error: SignalAnalyzerList class." << endl
+             << "const Signal_Analyzer& get_signal(const unsigned int) const method" << endl
+             << i << " should be < no_of_signals: " << no_of_signals << endl;
+
+        exit(1);
+    }
+
+    return S[i];
+}
+
+
+// int find_signal(const unsigned int) const method
+
+/// This method returns the position on the list of the signal with the given ID, or -1 if it is not on the list.
+/// @param signal_id ID of the signal.
+
+int Signal_Analyzer_List::find_signal(const unsigned int signal_id) const
+{
     for(unsigned int i=0; i<no_of_signals; i++)
     {
-        Signal_Analyzer s_an(signalsFileName, signalIDList[i]);
-        S.push_back(s_an);
+        if(S[i].get_signal_id() == signal_id)
+        {
+            return i;
+        }
     }
+
+    return -1;
 }
 
 
@@ -125,50 +908,181 @@ unsigned int Signal_Analyzer_List::get_num_signals(const char* const signalsFile
     stringstream ssLine(line);
     ssLine >> dNum;
 
-    //--Extracting the number of signals on file--//
-    while(ssLine >> dNum)
+    //--Extracting the number of signals on file--//
+    while(ssLine >> dNum)
+    {
+        num_signals++;
+    }
+
+
+    cout << endl << "Number of signals on file: " << num_signals << endl << endl;
+    inputFile.close();
+
+    return num_signals;
+}
+
+
+// void filter_signal(void) method
+
+/// This method filters crests and troughs of all the signals in the list.
+/// In pairwise filter mode each signal is filtered by taking as reference all other signals in the list, so each
+/// signal is filtered n-1 times, where n is the total number of signals. In consensus filter mode each signal is
+/// filtered once, against a period grid voted by all the signals.
+
+void Signal_Analyzer_List::filter_signal()
+{
+    if(filter_mode != CONSENSUS_FILTER || !filter_signal_consensus())
+    {
+        filter_signal_pairwise();
+    }
+
+    //--Show the number of Crests and Troughs found, for each signal, after filtering--//
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        cout << "Signal_" << S[i].get_signal_id() << ": No. of Crests found = " << S[i].get_crest_time_size()
+             << "   No. of Trough found = " << S[i].get_trough_time_size() << endl;
+    }
+}
+
+
+// void filter_signal_pairwise(void) method
+
+/// This method filters each signal by taking as reference, all other signals in the list.
+
+void Signal_Analyzer_List::filter_signal_pairwise()
+{
+    //--Filter signal crests and troughs individualy, by comparing each signal with the rest of the signals--//
+    for(unsigned int n=0; n<FILTER_EPOCH; n++)
+    {
+        for(unsigned int i=0; i<no_of_signals; i++)
+        {
+            for(unsigned int j=0; j<no_of_signals; j++)
+            {
+                if(i != j)
+                {
+                    S[i].filter_signal_crest(S[j]);
+                    S[i].filter_signal_trough(S[j]);
+                }
+            }
+        }
+    }
+}
+
+
+// bool filter_signal_consensus(void) method
+
+/// This method filters each signal once, against a period grid voted by all the signals.
+/// Each signal votes the intervals between the starts of its cycles. The votes of all the signals are merged in time
+/// order and cut into blocks of CONSENSUS_BLOCK_CYCLES cycles per voting signal, and each block gives a knot of the
+/// grid at its median time, with its median interval as the local period. A drifting frequency is thus followed, and
+/// the odd missed or extra cycle, of a signal too noisy or too flat to mark its cycles, is outvoted.
+/// Returns false, leaving the signals unfiltered, if no signal completes enough cycles to vote, or if fewer than a fraction
+/// CONSENSUS_AGREEMENT of the intervals lie within CONSENSUS_TOLERANCE of the local period, as then the signals share no period.
+
+bool Signal_Analyzer_List::filter_signal_consensus()
+{
+    //--Midpoint and length of every interval between cycle starts--//
+    vector<pair<double, double> > votes;
+    unsigned int no_voters = 0;
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        vector<double> cycle_start;
+        S[i].find_cycle_starts(cycle_start);
+
+        if(cycle_start.size() < 3)
+        {
+            continue;
+        }
+
+        no_voters++;
+        for(unsigned int k=0; k+1<cycle_start.size(); k++)
+        {
+            votes.push_back(make_pair((cycle_start[k] + cycle_start[k+1])/2.0, cycle_start[k+1] - cycle_start[k]));
+        }
+    }
+
+    if(votes.empty())
     {
-        num_signals++;
+        cout << "No signal completes enough cycles to vote a consensus period, filtering against every other signal" << endl;
+        return false;
     }
 
+    sort(votes.begin(), votes.end());
 
-    cout << endl << "Number of signals on file: " << num_signals << endl << endl;
-    inputFile.close();
+    const unsigned int block_size = CONSENSUS_BLOCK_CYCLES * no_voters;
+    const unsigned int no_blocks = max(1u, (unsigned int)(votes.size()/block_size));
 
-    return num_signals;
-}
+    Period_Grid grid;
+    unsigned int no_agreeing = 0;
 
+    for(unsigned int b=0; b<no_blocks; b++)
+    {
+        //--The last block takes the votes left over--//
+        const unsigned int begin = b*block_size;
+        const unsigned int end = b+1 == no_blocks ? votes.size() : begin+block_size;
 
-// void filter_signal(void) method
+        vector<double> interval;
+        for(unsigned int k=begin; k<end; k++)
+        {
+            interval.push_back(votes[k].second);
+        }
+        nth_element(interval.begin(), interval.begin() + interval.size()/2, interval.end());
 
-/// This method filters crests and troughs of all the signals in the list.
-/// Each signal is filteres by taking as reference, all other signals in the list.
-/// So each signal is filtered n-1 times, where n is the total number of signals.
+        const double period = interval[interval.size()/2];
 
-void Signal_Analyzer_List::filter_signal()
-{
-    //--Filter signal crests and troughs individualy, by comparing each signal with the rest of the signals--//
-    for(unsigned int n=0; n<FILTER_EPOCH; n++)
-    {
-        for(unsigned int i=0; i<no_of_signals; i++)
+        for(unsigned int k=0; k<interval.size(); k++)
         {
-            for(unsigned int j=0; j<no_of_signals; j++)
+            if(fabs(interval[k] - period) <= CONSENSUS_TOLERANCE*period)
             {
-                if(i != j)
-                {
-                    S[i].filter_signal_crest(S[j]);
-                    S[i].filter_signal_trough(S[j]);
-                }
+                no_agreeing++;
             }
         }
+
+        //--Cycles elapsed between knots, integrating the frequency interpolated linearly between them--//
+        const double time = votes[(begin+end)/2].first;
+
+        if(grid.time.empty())
+        {
+            grid.cycles.push_back(0.0);
+        }
+        else if(time > grid.time.back())
+        {
+            grid.cycles.push_back(grid.cycles.back() + (time - grid.time.back())*(1.0/grid.period.back() + 1.0/period)/2.0);
+        }
+        else
+        {
+            continue;
+        }
+        grid.time.push_back(time);
+        grid.period.push_back(period);
     }
 
-    //--Show the number of Crests and Troughs found, for each signal, after filtering--//
+    if(no_agreeing < CONSENSUS_AGREEMENT*votes.size())
+    {
+        cout << "Only " << no_agreeing << " of " << votes.size() << " cycles are within " << CONSENSUS_TOLERANCE*100.0
+             << "% of the consensus period, filtering against every other signal" << endl;
+        return false;
+    }
+
+    vector<double> period(grid.period);
+    nth_element(period.begin(), period.begin() + period.size()/2, period.end());
+
+    cout << "Consensus period = " << period[period.size()/2] << " s";
+    if(grid.period.size() > 1)
+    {
+        cout << " (" << *min_element(grid.period.begin(), grid.period.end()) << " to "
+             << *max_element(grid.period.begin(), grid.period.end()) << " s over " << grid.period.size() << " knots)";
+    }
+    cout << ", voted by " << no_voters << " of " << no_of_signals << " signals" << endl;
+
     for(unsigned int i=0; i<no_of_signals; i++)
     {
-        cout << "Signal_" << S[i].get_signal_id() << ": No. of Crests found = " << S[i].get_crest_time_size()
-             << "   No. of Trough found = " << S[i].get_trough_time_size() << endl;
+        S[i].filter_signal_crest(grid);
+        S[i].filter_signal_trough(grid);
     }
+
+    return true;
 }
 
 
@@ -241,23 +1155,81 @@ void Signal_Analyzer_List::show_signal_offsets(void)
 
 void Signal_Analyzer_List::calculate_phaseVector_crest(void)
 {
-    vector<vector<vector<double> > > phase;
-    vector<double> time;
+    calculate_phase_outputs(CREST_BASIS, false, true);
+}
 
-    fstream phaseFile_180;
-    fstream phaseFile_360;
 
-    //--Calculate phase difference between signals, for every pair of signals.
-    for(unsigned int i=0; i<no_of_signals-1; i++)
+// void calculate_phaseVector_trough(void) method
+
+/// Esimates phase difference between all pairs of signals on the list, as a vector,
+/// and then stores the same on a plottable file. Calculate the phase difference based
+/// on signal trough values.
+
+void Signal_Analyzer_List::calculate_phaseVector_trough(void)
+{
+    calculate_phase_outputs(TROUGH_BASIS, false, true);
+}
+
+
+// void calculate_phase_outputs(const Phase_Basis, const bool, const bool) method
+
+/// Calculates the phase difference between all pairs of signals on the list once, and from it displays the average
+/// phase difference of every pair, and/or stores the phase differences on a plottable file.
+/// @param basis Whether the phase difference is calculated based on signal crests, troughs or crossings.
+/// @param show_relation Whether the average phase difference of every pair is displayed.
+/// @param save_series Whether the phase differences are stored in the files 'phase180' and 'phase360'.
+
+void Signal_Analyzer_List::calculate_phase_outputs(const Phase_Basis basis, const bool show_relation, const bool save_series)
+{
+    if(show_relation)
     {
-        for(unsigned int j=i+1; j<no_of_signals; j++)
+        static const char* const basis_names[] = {"Crest", "Trough", "Crossing"};
+
+        cout << endl << "         " << basis_names[basis] << " based phase difference between pairs of signals (-180°, 180°]" << endl;
+    }
+
+    if(phase_mode == REFERENCE_PHASE)
+    {
+        const vector<vector<vector<double> > > reference_phase = calculate_reference_phases(basis);
+
+        if(show_relation)
+        {
+            show_reference_phase_relation(reference_phase);
+        }
+        if(save_series)
+        {
+            save_phase_series(derive_pair_phases(reference_phase));
+        }
+    }
+    else
+    {
+        const vector<vector<vector<double> > > phase = calculate_pair_phases(basis);
+
+        if(show_relation)
+        {
+            show_phase_relation(phase);
+        }
+        if(save_series)
         {
-            phase.push_back(S[i].calculate_phase_crest(S[j]));
+            save_phase_series(phase);
         }
     }
+}
+
+
+// void save_phase_series(const vector<vector<vector<double> > >&) method
+
+/// Stores the phase difference between all pairs of signals on the list on a plottable file.
+/// @param phase Phase difference vector of every pair of signals, as returned by calculate_pair_phases().
+
+void Signal_Analyzer_List::save_phase_series(const vector<vector<vector<double> > >& phase)
+{
+    vector<double> time;
 
-    phaseFile_180.open("../Output/phase180.dat", ios::out);
-    phaseFile_360.open("../Output/phase360.dat", ios::out);
+    Trace_Span span("save_phase_series", "output");
+
+    Series_Writer phaseFile_180("../Output/phase180", output_format, phase.size(), S[0].get_sample_step());
+    Series_Writer phaseFile_360("../Output/phase360", output_format, phase.size(), S[0].get_sample_step());
 
     //--Accumulate all unique time values from all the phase vectors.
     for(unsigned int i=0; i<phase.size(); i++)
@@ -275,10 +1247,11 @@ void Signal_Analyzer_List::calculate_phaseVector_crest(void)
     sort(time.begin(), time.end());
 
     //--Search the phase vectors and store the phase value closest to each time value, in phase graph file.
+    //--A pair without phase values at or after a time value is left as NaN.
     for(unsigned int n=0; n<time.size(); n++)
     {
-        phaseFile_180 << time[n];
-        phaseFile_360 << time[n];
+        vector<double> row_180(phase.size(), NAN);
+        vector<double> row_360(phase.size(), NAN);
 
         for(unsigned int i=0; i<phase.size(); i++)
         {
@@ -286,16 +1259,16 @@ void Signal_Analyzer_List::calculate_phaseVector_crest(void)
             {
                 if(phase[i][j][0] >= time[n])
                 {
-                    phaseFile_180 << " " << phase[i][j][1];
-                    phaseFile_360 << " " << phase[i][j][2];
+                    row_180[i] = phase[i][j][1];
+                    row_360[i] = phase[i][j][2];
 
                     break;
                 }
             }
         }
 
-        phaseFile_180 << endl;
-        phaseFile_360 << endl;
+        phaseFile_180.write_row(time[n], row_180);
+        phaseFile_360.write_row(time[n], row_360);
     }
 
     phaseFile_180.close();
@@ -303,158 +1276,274 @@ void Signal_Analyzer_List::calculate_phaseVector_crest(void)
 }
 
 
-// void calculate_phaseVector_trough(void) method
+// void show_signal_phase_relation_crest(void) method
 
-/// Esimates phase difference between all pairs of signals on the list, as a vector,
-/// and then stores the same on a plottable file. Calculate the phase difference based
-/// on signal trough values.
+/// Estimates and displays average phase difference between all pairs of signals on the list.
+/// Calculate the phase difference based on signal crest values.
 
-void Signal_Analyzer_List::calculate_phaseVector_trough(void)
+void Signal_Analyzer_List::show_phase_relation_crest(void)
 {
-    vector<vector<vector<double> > > phase;
-    vector<double> time;
+    calculate_phase_outputs(CREST_BASIS, true, false);
+}
+
+
+// void show_signal_phase_relation_trough(void) method
+
+/// Estimates and displays average phase difference between all pairs of signals on the list.
+/// Calculate the phase difference based on signal trough values.
+
+void Signal_Analyzer_List::show_phase_relation_trough(void)
+{
+    calculate_phase_outputs(TROUGH_BASIS, true, false);
+}
+
+
+// void show_phase_relation(const vector<vector<vector<double> > >&) method
+
+/// Displays the average phase difference between all pairs of signals on the list.
+/// @param phase Phase difference vector of every pair of signals, as returned by calculate_pair_phases().
+
+void Signal_Analyzer_List::show_phase_relation(const vector<vector<vector<double> > >& phase) const
+{
+    vector<double> avg_phase_diff;
+
+    for(unsigned int p=0; p<phase.size(); p++)
+    {
+        vector<double> phaseRelation;
+
+        for(unsigned int k=0; k<phase[p].size(); k++)
+        {
+            phaseRelation.push_back(phase[p][k][1]);
+        }
+        avg_phase_diff.push_back(accumulate(phaseRelation.begin(), phaseRelation.end(), 0.0)/phaseRelation.size());
+    }
+
+    show_pair_values(avg_phase_diff);
+}
+
+
+// void show_reference_phase_relation(const vector<vector<vector<double> > >&) method
+
+/// Displays the average phase difference between all pairs of signals on the list, in reference phase mode.
+/// The average phase of each signal W.R.T the reference signal is calculated once, as a circular mean,
+/// and the phase difference of each pair is the wrapped difference of the two averages.
+/// @param reference_phase Phase difference vector of every signal W.R.T the reference signal.
 
-    fstream phaseFile_180;
-    fstream phaseFile_360;
+void Signal_Analyzer_List::show_reference_phase_relation(const vector<vector<vector<double> > >& reference_phase) const
+{
+    vector<double> avg_phase_diff;
+    vector<double> reference_avg;
+
+    //--Circular mean of the phase of each signal W.R.T the reference signal--//
+    for(unsigned int k=0; k<no_of_signals; k++)
+    {
+        double sin_sum = 0.0;
+        double cos_sum = 0.0;
+
+        for(unsigned int n=0; n<reference_phase[k].size(); n++)
+        {
+            sin_sum += sin(reference_phase[k][n][2] * M_PI/180.0);
+            cos_sum += cos(reference_phase[k][n][2] * M_PI/180.0);
+        }
+        reference_avg.push_back(atan2(sin_sum, cos_sum) * 180.0/M_PI);
+    }
 
-    //--Calculate phase difference between signals, for every pair of signals.
     for(unsigned int i=0; i<no_of_signals-1; i++)
     {
         for(unsigned int j=i+1; j<no_of_signals; j++)
         {
-            phase.push_back(S[i].calculate_phase_trough(S[j]));
+            avg_phase_diff.push_back(wrap_phase_180(reference_avg[i] - reference_avg[j]));
         }
     }
 
-    phaseFile_180.open("../Output/phase180.dat", ios::out);
-    phaseFile_360.open("../Output/phase360.dat", ios::out);
+    show_pair_values(avg_phase_diff);
+}
+
 
-    //--Accumulate all unique time values from all the phase vectors.
-    for(unsigned int i=0; i<phase.size(); i++)
+// void show_pair_values(const vector<double>&) const method
+
+/// Displays a value per pair of signals, in degrees.
+/// @param value Value of every pair of signals (i, j), i < j, ordered by i and then by j.
+
+void Signal_Analyzer_List::show_pair_values(const vector<double>& value) const
+{
+    for(unsigned int i=0; i<no_of_signals-1; i++)
     {
-        for(unsigned int j=0; j<phase[i].size(); j++)
+        for(unsigned int j=i+1; j<no_of_signals; j++)
         {
-            if(find(time.begin(), time.end(), phase[i][j][0])==time.end())
-            {
-                time.push_back(phase[i][j][0]);
-            }
+            cout << "Signal_" << S[i].get_signal_id() << " AND Signal_"
+                 << S[j].get_signal_id() << ": " << value[get_pair_index(i, j)] << "°" << endl;
         }
     }
+}
 
-    //--Sort the time vector in accending order.
-    sort(time.begin(), time.end());
 
-    //--Search the phase vectors and store the phase value closest to each time value, in phase graph file.
-    for(unsigned int n=0; n<time.size(); n++)
+// vector<vector<vector<double> > > calculate_pair_phases(const Phase_Basis) const method
+
+/// This method returns the phase difference vector of every pair of signals (i, j), i < j, ordered by i and then by j.
+/// Each vector has the format of Signal_Analyzer::calculate_phase_crest(), for signal i W.R.T signal j.
+/// <ul>
+/// <li> In all pairs phase mode, every pair is calculated exactly. The pairs are split into tiles of
+///      PHASE_TILE_SIZE x PHASE_TILE_SIZE signals, which are processed in parallel by a thread pool.
+/// <li> In reference phase mode, each signal is calculated once W.R.T the reference signal. The phase of pair (i, j)
+///      at each time of signal i is the wrapped difference between the reference phase of signal i, and the
+///      reference phase of signal j closest in time.
+/// </ul>
+/// @param basis Whether the phase difference is calculated based on signal crests, troughs or crossings.
+
+vector<vector<vector<double> > > Signal_Analyzer_List::calculate_pair_phases(const Phase_Basis basis) const
+{
+    vector<vector<vector<double> > > phase(no_of_signals*(no_of_signals-1)/2);
+
+    if(phase_mode == REFERENCE_PHASE)
+    {
+        phase = derive_pair_phases(calculate_reference_phases(basis));
+    }
+    else
     {
-        phaseFile_180 << time[n];
-        phaseFile_360 << time[n];
+        Thread_Pool pool;
 
-        for(unsigned int i=0; i<phase.size(); i++)
+        for(unsigned int bi=0; bi<no_of_signals; bi+=PHASE_TILE_SIZE)
         {
-            for(unsigned int j=0; j<phase[i].size(); j++)
+            for(unsigned int bj=bi; bj<no_of_signals; bj+=PHASE_TILE_SIZE)
             {
-                if(phase[i][j][0] >= time[n])
-                {
-                    phaseFile_180 << " " << phase[i][j][1];
-                    phaseFile_360 << " " << phase[i][j][2];
-
-                    break;
-                }
+                pool.submit(bind(&Signal_Analyzer_List::calculate_phase_tile, this, bi, bj, basis, ref(phase)));
             }
         }
-
-        phaseFile_180 << endl;
-        phaseFile_360 << endl;
+        pool.wait();
     }
 
-    phaseFile_180.close();
-    phaseFile_360.close();
+    return phase;
 }
 
 
-// void show_signal_phase_relation_crest(void) method
+// vector<vector<vector<double> > > derive_pair_phases(const vector<vector<vector<double> > >&) const method
 
-/// Estimates and displays average phase difference between all pairs of signals on the list.
-/// Calculate the phase difference based on signal crest values.
+/// This method returns the phase difference vector of every pair of signals, derived from the phase of every signal
+/// W.R.T the reference signal. The phase of pair (i, j) at each time of signal i is the wrapped difference between
+/// the reference phase of signal i, and the reference phase of signal j closest in time.
+/// @param reference_phase Phase difference vector of every signal W.R.T the reference signal.
 
-void Signal_Analyzer_List::show_phase_relation_crest(void)
+vector<vector<vector<double> > > Signal_Analyzer_List::derive_pair_phases(const vector<vector<vector<double> > >& reference_phase) const
 {
-    double avg_phase_diff;
-
-    cout << endl << "         Crest based phase difference between pairs of signals (-180°, 180°]" << endl;
+    vector<vector<vector<double> > > phase(no_of_signals*(no_of_signals-1)/2);
+    vector<double> phase_individual(3);
 
-    //--Calculate phase difference between signals, for every pair of signals.
     for(unsigned int i=0; i<no_of_signals-1; i++)
     {
         for(unsigned int j=i+1; j<no_of_signals; j++)
         {
-            vector<vector<double> > phaseVector;
-            vector<double> phaseRelation;
+            const vector<vector<double> >& phase_i = reference_phase[i];
+            const vector<vector<double> >& phase_j = reference_phase[j];
+            vector<vector<double> >& pair_phase = phase[get_pair_index(i, j)];
 
-            phaseVector = S[i].calculate_phase_crest(S[j]);
-
-            for(unsigned int k=0; k<phaseVector.size(); k++)
+            if(phase_j.empty())
             {
-                phaseRelation.push_back(phaseVector[k][1]);
+                continue;
             }
-            avg_phase_diff = accumulate(phaseRelation.begin(), phaseRelation.end(), 0.0)/phaseRelation.size();
 
-            cout << "Signal_" << S[i].get_signal_id() << " AND Signal_"
-                 << S[j].get_signal_id() << ": " << avg_phase_diff << "°" << endl;
+            //--Both vectors are in time order, so the closest sample of signal j only moves forward--//
+            unsigned int m = 0;
+            for(unsigned int n=0; n<phase_i.size(); n++)
+            {
+                while(m+1 < phase_j.size() && fabs(phase_j[m+1][0]-phase_i[n][0]) <= fabs(phase_j[m][0]-phase_i[n][0]))
+                {
+                    m++;
+                }
+
+                phase_individual[0] = phase_i[n][0];
+                phase_individual[2] = wrap_phase_360(phase_i[n][2] - phase_j[m][2]);
+                phase_individual[1] = wrap_phase_180(phase_individual[2]);
+
+                pair_phase.push_back(phase_individual);
+            }
         }
     }
 
+    return phase;
 }
 
 
-// void show_signal_phase_relation_trough(void) method
+// vector<vector<vector<double> > > calculate_reference_phases(const Phase_Basis) const method
 
-/// Estimates and displays average phase difference between all pairs of signals on the list.
-/// Calculate the phase difference based on signal trough values.
+/// This method returns the phase difference vector of every signal W.R.T the reference signal, PHASE_REFERENCE.
+/// This takes one phase calculation per signal.
+/// @param basis Whether the phase difference is calculated based on signal crests, troughs or crossings.
 
-void Signal_Analyzer_List::show_phase_relation_trough(void)
+vector<vector<vector<double> > > Signal_Analyzer_List::calculate_reference_phases(const Phase_Basis basis) const
 {
-    double avg_phase_diff;
+    vector<vector<vector<double> > > reference_phase(no_of_signals);
 
-    cout << endl << "         Trough based phase difference between pairs of signals (-180°, 180°]" << endl;
-
-    //--Calculate phase difference between signals, for every pair of signals.
-    for(unsigned int i=0; i<no_of_signals-1; i++)
+    for(unsigned int k=0; k<no_of_signals; k++)
     {
-        for(unsigned int j=i+1; j<no_of_signals; j++)
-        {
-            vector<vector<double> > phaseVector;
-            vector<double> phaseRelation;
+        reference_phase[k] = S[k].calculate_phase(S[PHASE_REFERENCE], basis);
+    }
 
-            phaseVector = S[i].calculate_phase_trough(S[j]);
+    return reference_phase;
+}
 
-            for(unsigned int k=0; k<phaseVector.size(); k++)
-            {
-                phaseRelation.push_back(phaseVector[k][1]);
-            }
-            avg_phase_diff = accumulate(phaseRelation.begin(), phaseRelation.end(), 0.0)/phaseRelation.size();
 
-            cout << "Signal_" << S[i].get_signal_id() << " AND Signal_"
-                 << S[j].get_signal_id() << ": " << avg_phase_diff << "°" << endl;
+// void calculate_phase_tile(const unsigned int, const unsigned int, const Phase_Basis, vector<vector<vector<double> > >&) const method
+
+/// This method calculates the phase difference vector of every pair (i, j), i < j, with i in the tile starting at
+/// signal tile_i and j in the tile starting at signal tile_j. Different tiles write to different pairs.
+/// @param tile_i First signal of the row tile.
+/// @param tile_j First signal of the column tile.
+/// @param basis Whether the phase difference is calculated based on signal crests, troughs or crossings.
+/// @param phase Phase difference vectors of all pairs, indexed by get_pair_index().
+
+void Signal_Analyzer_List::calculate_phase_tile(const unsigned int tile_i, const unsigned int tile_j, const Phase_Basis basis,
+                                                vector<vector<vector<double> > >& phase) const
+{
+    const unsigned int end_i = min(tile_i + PHASE_TILE_SIZE, no_of_signals);
+    const unsigned int end_j = min(tile_j + PHASE_TILE_SIZE, no_of_signals);
+
+    for(unsigned int i=tile_i; i<end_i; i++)
+    {
+        for(unsigned int j=max(tile_j, i+1); j<end_j; j++)
+        {
+            phase[get_pair_index(i, j)] = S[i].calculate_phase(S[j], basis);
         }
     }
+}
 
+
+// unsigned int get_pair_index(const unsigned int, const unsigned int) const method
+
+/// This method returns the position of the pair of signals (i, j), i < j, in the list of all pairs ordered by i and then by j.
+/// @param i Position of the first signal of the pair.
+/// @param j Position of the second signal of the pair.
+
+unsigned int Signal_Analyzer_List::get_pair_index(const unsigned int i, const unsigned int j) const
+{
+    return i*(2*no_of_signals - i - 1)/2 + (j - i - 1);
 }
 
 
-// void show_signal_frequency(void) method
+// void show_signal_frequency(const Phase_Basis) method
 
 /// Estimates and displays average frequency of all the signals on the list.
+/// @param basis Whether the frequency is estimated from the periods between signal crests, troughs or crossings.
 
-void Signal_Analyzer_List::show_signal_frequency(void)
+void Signal_Analyzer_List::show_signal_frequency(const Phase_Basis basis)
 {
     vector<double> frequency;
     double avg_freq;
 
     for(unsigned int i=0; i<no_of_signals; i++)
     {
-        frequency.push_back(S[i].estimate_frequency_trough());
+        if(basis == CREST_BASIS)
+        {
+            frequency.push_back(S[i].estimate_frequency_crest());
+        }
+        else if(basis == TROUGH_BASIS)
+        {
+            frequency.push_back(S[i].estimate_frequency_trough());
+        }
+        else
+        {
+            frequency.push_back(S[i].estimate_frequency_crossing());
+        }
     }
     avg_freq = accumulate(frequency.begin(), frequency.end(), 0.0)/frequency.size();
 
@@ -480,3 +1569,98 @@ void Signal_Analyzer_List::show_signal_range(void)
         cout << "Signal_" << S[i].get_signal_id() << ": [" << (amplitude + offset) << ":" << (-amplitude + offset) << "]" << endl;
     }
 }
+
+
+// void calculate_cycle_series(void) method
+
+/// Calculates the amplitude, offset and frequency of every crest-trough-crest cycle of all the signals on the list,
+/// and stores them on a plottable file per signal, 'S<signal_id>_cycles', with the columns
+/// time, amplitude, offset and frequency. The time of a cycle is the time of its trough.
+
+void Signal_Analyzer_List::calculate_cycle_series(void)
+{
+    cout << endl << "         Signal Cycles" << endl;
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        Cycle_Series series = S[i].calculate_cycle_series();
+        const vector<Cycle>& cycles = series.get_cycles();
+
+        Trace_Span span("save_cycle_series", "output", S[i].get_signal_id());
+
+        stringstream ss;
+        ss << "../Output/S" << S[i].get_signal_id() << "_cycles";
+
+        Series_Writer cycleFile(ss.str(), output_format, 3, S[i].get_sample_step());
+        vector<double> row(3);
+
+        for(unsigned int k=0; k<cycles.size(); k++)
+        {
+            row[0] = cycles[k].amplitude;
+            row[1] = cycles[k].offset;
+            row[2] = cycles[k].frequency;
+
+            cycleFile.write_row(cycles[k].time, row);
+        }
+        cycleFile.close();
+
+        cout << "Signal_" << S[i].get_signal_id() << ": No. of Cycles = " << cycles.size() << endl;
+    }
+}
+
+
+// void save_signal_envelopes(const double, const double, const unsigned int) const method
+
+/// Saves a plot-ready min/max envelope of every signal on the list over the time window [t0,t1],
+/// to a file per signal, 'S<signal_id>_envelope', with the columns time, minimum and maximum.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+/// @param width Number of rows per file, usually the width of the plot in pixels.
+
+void Signal_Analyzer_List::save_signal_envelopes(const double t0, const double t1, const unsigned int width) const
+{
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        S[i].save_envelope(t0, t1, width);
+    }
+}
+
+
+// void show_memory_usage(void) const method
+
+/// Shows the bytes held by every signal on the list: its time column, samples, min/max pyramid and extrema.
+
+void Signal_Analyzer_List::show_memory_usage(void) const
+{
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        const Signal_Memory memory = S[i].get_memory_usage();
+
+        cout << "Signal_" << S[i].get_signal_id() << ": Time = " << memory.time/BYTES_PER_MB << " MB"
+             << "   Samples = " << memory.samples/BYTES_PER_MB << " MB"
+             << "   Pyramid = " << memory.pyramid/BYTES_PER_MB << " MB"
+             << "   Extrema = " << memory.extrema/BYTES_PER_MB << " MB" << endl;
+    }
+}
+
+
+// void save_extrema_state(ostream&) const method
+
+/// This method writes the signal IDs, followed by the crests, troughs and crossings of every signal as they stand,
+/// so that a later run can carry on from them through the istream constructor without reading the data file.
+/// @param stateFile Stream the state is written to.
+
+void Signal_Analyzer_List::save_extrema_state(ostream& stateFile) const
+{
+    stateFile << "signals " << no_of_signals;
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        stateFile << " " << S[i].get_signal_id();
+    }
+    stateFile << endl;
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        S[i].save_extrema_state(stateFile);
+    }
+}
@@ -16,15 +16,98 @@
 #ifndef SIGNAL_ANALYZER_LIST_H
 #define SIGNAL_ANALYZER_LIST_H
 
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include "signal_analyzer.h"
+#include "thread_pool.h"
+#include "allocation_tracker.h"
 
 #define FILTER_EPOCH 1
 
+//--How the signal data is read from file--//
+enum Ingest_Mode
+{
+    SEQUENTIAL_INGEST,   // The file is parsed once, then the crests and troughs of each signal are selected.
+    PIPELINED_INGEST     // The file is parsed once, overlapped with crest and trough detection. See Signal_Pipeline.
+};
+
+//--How the signal data is read from file, and how much of it may be held at once--//
+struct Ingest_Options
+{
+    Ingest_Options(const Ingest_Mode ingest_mode = SEQUENTIAL_INGEST) : mode(ingest_mode), memory_budget(0), checkpoint(NULL), extrema_output(true), detection(FULL_DETECTION), crossings(false),
+                                                                read_window(false), window_start(0.0), window_end(0.0) {}
+
+    Ingest_Mode mode;
+
+    //--Bytes of signal data held at once. Signals are then read in column groups, and only their extrema are kept.
+    //  Zero reads all the signals at once and keeps their data--//
+    unsigned long memory_budget;
+
+    //--Median or Hampel filter applied to every signal as it is read, ahead of crest and trough detection--//
+    Prefilter_Options prefilter;
+
+    //--File holding the detection state of a previous run, which is resumed on the rows appended since, and then updated.
+    //  NULL reads the whole file--//
+    const char* checkpoint;
+
+    //--Whether the crests and troughs of every signal are saved to file, as selected and as filtered--//
+    bool extrema_output;
+
+    //--Whether every sample is searched for crest and trough candidates, or only the blocks that may hold one--//
+    Detection_Mode detection;
+
+    //--Whether the crossings of the signal mean are found, for the crossing based phase and frequency--//
+    bool crossings;
+
+    //--Whether only the rows with time within [window_start:window_end] are read. Time grows down the file, so the
+    //  first and last of them are found by binary search--//
+    bool read_window;
+    double window_start;
+    double window_end;
+};
+
+//--How the crests and troughs of each signal are filtered against the other signals--//
+enum Filter_Mode
+{
+    PAIRWISE_FILTER,     // Each signal is filtered against every other signal, n(n-1) passes for n signals.
+    CONSENSUS_FILTER     // Each signal is filtered once, against a period grid voted by all the signals.
+};
+
+//--Cycles of every voting signal over which the consensus filter takes the median period, per knot of the grid--//
+#define CONSENSUS_BLOCK_CYCLES 8
+
+//--Relative distance from the local period within which a cycle agrees with it, and fraction of the cycles that must agree
+//  for the grid to be used--//
+#define CONSENSUS_TOLERANCE 0.1
+#define CONSENSUS_AGREEMENT 0.75
+
+//--How the phase difference of every pair of signals is obtained--//
+enum Phase_Mode
+{
+    ALL_PAIRS_PHASE,     // Each pair is measured directly. Pairs are processed in tiles across a thread pool.
+    REFERENCE_PHASE      // Each signal is measured once against a reference signal, and pairs are derived by subtraction.
+};
+
+#define PHASE_REFERENCE 0
+#define PHASE_TILE_SIZE 8
+
+//--Bytes searched backwards for the last line before a checkpoint offset--//
+#define CHECKPOINT_LINE_SCAN 4096
+
 class Signal_Analyzer_List
 {
 public:
-    Signal_Analyzer_List(const char*);
-    Signal_Analyzer_List(const char*, const vector<unsigned int>&);
+    Signal_Analyzer_List(const char*, const Ingest_Options& = Ingest_Options(), const Output_Format = TEXT_OUTPUT);
+    Signal_Analyzer_List(const char*, const vector<unsigned int>&, const Ingest_Options& = Ingest_Options(), const Output_Format = TEXT_OUTPUT);
+    Signal_Analyzer_List(istream&, const Ingest_Options& = Ingest_Options(), const Output_Format = TEXT_OUTPUT);
+
+    static void remove_output_files(void);
 
     unsigned int get_num_signals(const char* const signalsFileName) const;
 
@@ -36,11 +119,55 @@ public:
     void calculate_phaseVector_trough(void);
     void show_phase_relation_crest(void);
     void show_phase_relation_trough(void);
-    void show_signal_frequency(void);
+    void calculate_phase_outputs(const Phase_Basis, const bool, const bool);
+    void show_signal_frequency(const Phase_Basis = TROUGH_BASIS);
     void show_signal_range(void);
+    void calculate_cycle_series(void);
+    void save_signal_envelopes(const double, const double, const unsigned int) const;
+    void show_memory_usage(void) const;
+
+    void save_extrema_state(ostream&) const;
+
+    void set_phase_mode(const Phase_Mode);
+    void set_filter_mode(const Filter_Mode);
+
+    unsigned int get_no_of_signals(void) const;
+    const Signal_Analyzer& get_signal(const unsigned int) const;
+    int find_signal(const unsigned int) const;
+
+    vector<vector<vector<double> > > calculate_pair_phases(const Phase_Basis) const;
+    unsigned int get_pair_index(const unsigned int, const unsigned int) const;
 
 private:
+    void load_signals(const char* const, const vector<unsigned int>&, const Ingest_Options&);
+    void read_signals(const char* const, const vector<unsigned int>&, vector<Signal_Analyzer>&, const unsigned long = 0, const unsigned long = ULONG_MAX) const;
+    unsigned int count_rows(const char* const, const unsigned long = 0, const unsigned long = ULONG_MAX) const;
+
+    unsigned long read_checkpoint(const char* const, const char* const, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, vector<string>&) const;
+    void write_checkpoint(const char* const, const char* const, const unsigned long, const vector<unsigned int>&, const Prefilter_Options&, const Detection_Mode, const vector<string>&) const;
+    unsigned long find_end_of_lines(const char* const) const;
+    string read_line_before(const char* const, const unsigned long) const;
+
+    void find_time_range(const char* const, const double, const double, unsigned long&, unsigned long&) const;
+    unsigned long find_row_at_time(const char* const, const unsigned long, const double, const bool) const;
+    unsigned long find_next_row(const char* const, const unsigned long, const unsigned long, double&) const;
+
+    void filter_signal_pairwise(void);
+    bool filter_signal_consensus(void);
+
+    void save_phase_series(const vector<vector<vector<double> > >&);
+    void show_phase_relation(const vector<vector<vector<double> > >&) const;
+    void show_reference_phase_relation(const vector<vector<vector<double> > >&) const;
+    void show_pair_values(const vector<double>&) const;
+
+    vector<vector<vector<double> > > calculate_reference_phases(const Phase_Basis) const;
+    vector<vector<vector<double> > > derive_pair_phases(const vector<vector<vector<double> > >&) const;
+    void calculate_phase_tile(const unsigned int, const unsigned int, const Phase_Basis, vector<vector<vector<double> > >&) const;
+
     unsigned int no_of_signals;
+    Phase_Mode phase_mode;
+    Filter_Mode filter_mode;
+    Output_Format output_format;
     vector<Signal_Analyzer> S;
 
 };
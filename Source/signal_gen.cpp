@@ -0,0 +1,124 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I G N A L   G E N E R A T O R   M A I N                                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "signal_generator.h"
+
+
+int main(int argc, char* argv[])
+{
+    Generator_Settings settings;
+    char* fileName = NULL;
+
+    for(int i=1; i<argc; i++)
+    {
+        string arg(argv[i]);
+        const bool has_value = i+1 < argc;
+
+        if(arg == "--channels" && has_value)
+        {
+            settings.no_channels = atoi(argv[++i]);
+        }
+        else if(arg == "--duration" && has_value)
+        {
+            settings.duration = atof(argv[++i]);
+        }
+        else if(arg == "--rate" && has_value)
+        {
+            settings.sample_rate = atof(argv[++i]);
+        }
+        else if(arg == "--frequency" && has_value)
+        {
+            settings.frequency = atof(argv[++i]);
+        }
+        else if(arg == "--drift" && has_value)
+        {
+            settings.drift = atof(argv[++i]);
+        }
+        else if(arg == "--channel" && has_value)
+        {
+            //--amplitude,offset,phase of the next channel--//
+            Channel_Parameters channel;
+
+            if(sscanf(argv[++i], "%lf,%lf,%lf", &channel.amplitude, &channel.offset, &channel.phase) != 3)
+            {
+                cerr << "SignalAnalyzer Error: SignalGen." << endl
+                     << "main(int, char*) method" << endl
+                     << "Expected amplitude,offset,phase: " << argv[i] << endl;
+
+                exit(1);
+            }
+            settings.channels.push_back(channel);
+        }
+        else if(arg == "--noise" && has_value)
+        {
+            settings.noise = atof(argv[++i]);
+        }
+        else if(arg == "--spikes" && has_value)
+        {
+            settings.spike_rate = atof(argv[++i]);
+        }
+        else if(arg == "--spike-size" && has_value)
+        {
+            settings.spike_size = atof(argv[++i]);
+        }
+        else if(arg == "--plateaus" && has_value)
+        {
+            settings.plateau_rate = atof(argv[++i]);
+        }
+        else if(arg == "--plateau-length" && has_value)
+        {
+            settings.plateau_length = atoi(argv[++i]);
+        }
+        else if(arg == "--comments" && has_value)
+        {
+            settings.comment_interval = atoi(argv[++i]);
+        }
+        else if(arg == "--threads" && has_value)
+        {
+            settings.no_threads = atoi(argv[++i]);
+        }
+        else if(arg == "--seed" && has_value)
+        {
+            settings.seed = strtoul(argv[++i], NULL, 10);
+        }
+        else if(arg.compare(0, 2, "--") != 0 && fileName == NULL)
+        {
+            fileName = argv[i];
+        }
+        else
+        {
+            cerr << "SignalAnalyzer Error: SignalGen." << endl
+                 << "main(int, char*) method" << endl
+                 << "Unknown or repeated command line parameter: "<< arg << endl;
+            fileName = NULL;
+            break;
+        }
+    }
+
+    if(fileName == NULL)
+    {
+        cerr << "Usage: SignalGen [--channels N] [--duration s] [--rate Hz] [--frequency Hz] [--drift Hz/s]" << endl
+             << "                 [--channel amplitude,offset,phase]... [--noise sigma] [--spikes per_s] [--spike-size value]" << endl
+             << "                 [--plateaus per_s] [--plateau-length samples] [--comments every_rows]" << endl
+             << "                 [--threads N] [--seed N] output_file" << endl;
+
+        exit(1);
+    }
+
+    Signal_Generator generator(settings);
+    generator.generate(fileName);
+
+    return 0;
+}
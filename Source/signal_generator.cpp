@@ -0,0 +1,341 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I G N A L   G E N E R A T O R   C L A S S                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include <chrono>
+
+#include "signal_generator.h"
+
+// void append_fixed(string&, double, const unsigned int) function
+
+/// Appends a number in fixed point notation to a string. Much faster than the stream and printf formatting,
+/// which dominate the generation time otherwise. Valid for magnitudes below 1e9.
+/// @param out String the number is appended to.
+/// @param value Number.
+/// @param decimals Digits after the decimal point, at most 9.
+
+static void append_fixed(string& out, double value, const unsigned int decimals)
+{
+    static const double scale[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+    char digits[32];
+    char* cursor = digits + sizeof(digits);
+
+    unsigned long long scaled = (unsigned long long)(fabs(value)*scale[decimals] + 0.5);
+
+    //--No sign for values that round to zero--//
+    const bool negative = value < 0.0 && scaled > 0;
+
+    //--Digits are produced from the last one backwards--//
+    for(unsigned int d=0; d<decimals; d++)
+    {
+        *--cursor = '0' + scaled%10;
+        scaled /= 10;
+    }
+    if(decimals > 0)
+    {
+        *--cursor = '.';
+    }
+    do
+    {
+        *--cursor = '0' + scaled%10;
+        scaled /= 10;
+    }while(scaled > 0);
+
+    if(negative)
+    {
+        *--cursor = '-';
+    }
+
+    out.append(cursor, digits + sizeof(digits) - cursor);
+}
+
+
+// CONSTRUCTOR
+
+/// Sets the default settings: four channels of 120 s at 1 kHz and 1.2345678 Hz, like 'Data/signals.dat', without disturbances.
+
+Generator_Settings::Generator_Settings(void)
+{
+    no_channels = 4;
+    duration = 120.0;
+    sample_rate = 1000.0;
+    frequency = 1.2345678;
+    drift = 0.0;
+
+    noise = 0.0;
+    spike_rate = 0.0;
+    spike_size = 20.0;
+    plateau_rate = 0.0;
+    plateau_length = 50;
+    comment_interval = 0;
+
+    no_threads = 0;
+    seed = 1;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a Signal Generator object.
+/// The parameters of the channels not given in the settings are drawn at random from the seed:
+/// amplitude in [10,50], offset in [-20,20] and phase in [-180°,180°), rounded to one decimal.
+/// @param generatorSettings Settings of the signals to be generated.
+
+Signal_Generator::Signal_Generator(const Generator_Settings& generatorSettings)
+{
+    settings = generatorSettings;
+
+    if(settings.no_channels == 0 || settings.sample_rate <= 0.0 || settings.duration < 0.0)
+    {
+        cerr << "SignalAnalyzer Error: SignalGenerator class." << endl
+             << "Signal_Generator(const Generator_Settings&) method" << endl
+             << "Needs at least one channel, a positive sample rate and a non-negative duration" << endl;
+
+        exit(1);
+    }
+
+    mt19937_64 rng(settings.seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for(unsigned int c=settings.channels.size(); c<settings.no_channels; c++)
+    {
+        Channel_Parameters channel;
+
+        channel.amplitude = round((10.0 + 40.0*uniform(rng)) * 10.0)/10.0;
+        channel.offset = round((-20.0 + 40.0*uniform(rng)) * 10.0)/10.0;
+        channel.phase = round((-180.0 + 360.0*uniform(rng)) * 10.0)/10.0;
+
+        settings.channels.push_back(channel);
+    }
+    settings.channels.resize(settings.no_channels);
+
+    no_rows = (unsigned long)floor(settings.duration*settings.sample_rate + 1e-9) + 1;
+
+    //--Fewest decimals that represent every sampling time exactly--//
+    for(time_decimals=0; time_decimals<9; time_decimals++)
+    {
+        const double steps = pow(10.0, time_decimals)/settings.sample_rate;
+        if(fabs(steps - round(steps)) < 1e-9*steps)
+        {
+            break;
+        }
+    }
+}
+
+
+// void generate(const char* const) method
+
+/// This method writes the signals data file, and the ground truth of the signals to '<fileName>.truth'.
+/// The rows are cut into chunks of GENERATOR_CHUNK_ROWS, which are formatted in parallel on a thread pool,
+/// a wave of two chunks per thread at a time. The calling thread writes each wave while the next one is formatted.
+/// @param fileName Path and name of the signals data file.
+
+void Signal_Generator::generate(const char* const fileName)
+{
+    fstream outputFile;
+
+    outputFile.open(fileName, ios::out | ios::binary);
+    if(!outputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalGenerator class." << endl
+             << "void generate(const char* const) method" << endl
+             << "Cannot open file: "<< fileName  << endl;
+
+        exit(1);
+    }
+
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    outputFile << "# Time\t";
+    for(unsigned int c=0; c<settings.no_channels; c++)
+    {
+        outputFile << "\tSignal_" << c+1;
+    }
+    outputFile << endl;
+
+    Thread_Pool pool(settings.no_threads);
+
+    const unsigned long no_chunks = (no_rows + GENERATOR_CHUNK_ROWS - 1)/GENERATOR_CHUNK_ROWS;
+    const unsigned long wave = 2*pool.get_num_threads();
+
+    vector<string> buffers[2];
+    buffers[0].resize(wave);
+    buffers[1].resize(wave);
+
+    unsigned long no_bytes = 0;
+    unsigned int current = 0;
+
+    for(unsigned long first=0; first<no_chunks+wave; first+=wave, current^=1)
+    {
+        for(unsigned long k=0; k<wave && first+k<no_chunks; k++)
+        {
+            pool.submit(bind(&Signal_Generator::generate_chunk, this, first+k, ref(buffers[current][k])));
+        }
+
+        //--Write the previous wave while the current one is being formatted--//
+        for(unsigned long k=0; first>=wave && k<wave && first-wave+k<no_chunks; k++)
+        {
+            outputFile.write(buffers[current^1][k].data(), buffers[current^1][k].size());
+            no_bytes += buffers[current^1][k].size();
+        }
+
+        pool.wait();
+    }
+    outputFile.close();
+
+    save_ground_truth(fileName);
+
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Generated " << no_rows << " rows of " << settings.no_channels << " signals, "
+         << no_bytes/(1024*1024) << " MB in " << seconds << " s ("
+         << no_bytes/(1024*1024)/max(seconds, 1e-9) << " MB/s) on " << pool.get_num_threads() << " threads" << endl;
+}
+
+
+// void generate_chunk(const unsigned long, string&) const method
+
+/// This method formats one chunk of rows. Each chunk draws its noise, spikes and plateaus from its own random
+/// generator, seeded with the seed and the chunk number, so the file does not depend on the number of threads.
+/// A plateau does not continue past the end of its chunk.
+/// @param chunk Number of the chunk.
+/// @param buffer Formatted rows.
+
+void Signal_Generator::generate_chunk(const unsigned long chunk, string& buffer) const
+{
+    const unsigned long first_row = chunk*GENERATOR_CHUNK_ROWS;
+    const unsigned long last_row = min(first_row + GENERATOR_CHUNK_ROWS, no_rows);
+    const unsigned int no_channels = settings.no_channels;
+
+    seed_seq chunk_seed = {(unsigned long)settings.seed, chunk};
+    mt19937_64 rng(chunk_seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    normal_distribution<double> gaussian(0.0, settings.noise > 0.0 ? settings.noise : 1.0);
+
+    const double spike_probability = settings.spike_rate/settings.sample_rate;
+    const double plateau_probability = settings.plateau_rate/settings.sample_rate;
+
+    vector<unsigned int> plateau_left(no_channels, 0);
+    vector<double> plateau_value(no_channels, 0.0);
+
+    buffer.clear();
+    buffer.reserve((last_row - first_row)*(no_channels + 1)*12);
+
+    for(unsigned long r=first_row; r<last_row; r++)
+    {
+        if(settings.comment_interval > 0 && r > 0 && r % settings.comment_interval == 0)
+        {
+            buffer += "# SignalGen row ";
+            buffer += to_string(r);
+            buffer += '\n';
+        }
+
+        const double t = r/settings.sample_rate;
+
+        //--Cycles elapsed since t = 0, with the frequency drifting linearly. Only the fraction matters to sin(),
+        //  and keeping its argument small keeps it on the fast path of the math library--//
+        double cycles = settings.frequency*t + 0.5*settings.drift*t*t;
+        cycles -= floor(cycles);
+
+        append_fixed(buffer, t, time_decimals);
+
+        for(unsigned int c=0; c<no_channels; c++)
+        {
+            const Channel_Parameters& channel = settings.channels[c];
+            double value;
+
+            if(plateau_left[c] > 0)
+            {
+                value = plateau_value[c];
+                plateau_left[c]--;
+            }
+            else
+            {
+                value = channel.amplitude*sin(2.0*M_PI*cycles + channel.phase*M_PI/180.0) + channel.offset;
+
+                if(settings.noise > 0.0)
+                {
+                    value += gaussian(rng);
+                }
+
+                if(plateau_probability > 0.0 && uniform(rng) < plateau_probability)
+                {
+                    plateau_value[c] = value;
+                    plateau_left[c] = settings.plateau_length > 0 ? settings.plateau_length - 1 : 0;
+                }
+                else if(spike_probability > 0.0 && uniform(rng) < spike_probability)
+                {
+                    value += (uniform(rng) < 0.5) ? -settings.spike_size : settings.spike_size;
+                }
+            }
+
+            buffer += ' ';
+            append_fixed(buffer, value, GENERATOR_VALUE_DECIMALS);
+        }
+        buffer += '\n';
+    }
+}
+
+
+// void save_ground_truth(const string&) const method
+
+/// This method writes the parameters the signals were generated with to '<fileName>.truth'.
+/// The frequency of each signal is its average over the recording. Phase follows the convention of 'Data/signals.dat',
+/// so the phase difference reported for Signal_i AND Signal_j is phase_j - phase_i.
+/// @param fileName Path and name of the signals data file.
+
+void Signal_Generator::save_ground_truth(const string& fileName) const
+{
+    fstream truthFile;
+    const string truthFileName = fileName + ".truth";
+
+    truthFile.open(truthFileName.c_str(), ios::out);
+    if(!truthFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalGenerator class." << endl
+             << "void save_ground_truth(const string&) const method" << endl
+             << "Cannot open file: "<< truthFileName  << endl;
+
+        exit(1);
+    }
+
+    truthFile.precision(10);
+    truthFile << "# SignalGen ground truth of " << fileName << endl
+              << "# rows " << no_rows << " duration " << settings.duration << " sample_rate " << settings.sample_rate
+              << " frequency " << settings.frequency << " drift " << settings.drift << endl
+              << "# noise " << settings.noise << " spike_rate " << settings.spike_rate << " spike_size " << settings.spike_size
+              << " plateau_rate " << settings.plateau_rate << " plateau_length " << settings.plateau_length
+              << " comment_interval " << settings.comment_interval << " seed " << settings.seed << endl
+              << "# Signal\tAmplitude\tOffset\tPhase\tFrequency" << endl;
+
+    const double average_frequency = settings.frequency + 0.5*settings.drift*settings.duration;
+
+    for(unsigned int c=0; c<settings.no_channels; c++)
+    {
+        truthFile << c+1 << "\t" << settings.channels[c].amplitude << "\t" << settings.channels[c].offset
+                  << "\t" << settings.channels[c].phase << "\t" << average_frequency << endl;
+    }
+    truthFile.close();
+}
+
+
+// unsigned long get_no_rows(void) const method
+
+/// This method returns the number of data rows of the generated file.
+
+unsigned long Signal_Generator::get_no_rows(void) const
+{
+    return no_rows;
+}
@@ -0,0 +1,85 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I G N A L   G E N E R A T O R   C L A S S   H E A D E R                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SIGNAL_GENERATOR_H
+#define SIGNAL_GENERATOR_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <math.h>
+#include <stdlib.h>
+
+#include "thread_pool.h"
+
+//--Rows formatted by one task, and digits after the decimal point of the signal values--//
+#define GENERATOR_CHUNK_ROWS 16384
+#define GENERATOR_VALUE_DECIMALS 4
+
+//--Sinusoid parameters of one channel. Phase in degrees--//
+struct Channel_Parameters
+{
+    double amplitude;
+    double offset;
+    double phase;
+};
+
+struct Generator_Settings
+{
+    Generator_Settings(void);
+
+    unsigned int no_channels;
+    double duration;             // s
+    double sample_rate;          // Hz
+    double frequency;            // Hz, at t = 0
+    double drift;                // Hz/s, linear change of the frequency over time
+
+    double noise;                // Standard deviation of the additive Gaussian noise
+    double spike_rate;           // Single sample spikes per second, per channel
+    double spike_size;           // Height of a spike. Above NOISE_THRESHOLD, so the analyzer steps over it
+    double plateau_rate;         // Flat plateaus per second, per channel
+    unsigned int plateau_length; // Samples a plateau holds its value
+    unsigned int comment_interval; // Rows between comment lines, 0 for none
+
+    unsigned int no_threads;     // 0 for one per hardware thread
+    unsigned long seed;
+
+    //--Parameters of the first channels. The rest are drawn at random from the seed--//
+    vector<Channel_Parameters> channels;
+};
+
+class Signal_Generator
+{
+public:
+    Signal_Generator(const Generator_Settings&);
+
+    void generate(const char* const);
+
+    unsigned long get_no_rows(void) const;
+
+private:
+    void generate_chunk(const unsigned long, string&) const;
+    void save_ground_truth(const string&) const;
+
+    Generator_Settings settings;
+
+    unsigned long no_rows;
+    unsigned int time_decimals;
+};
+
+#endif // SIGNAL_GENERATOR_H
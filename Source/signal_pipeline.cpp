@@ -0,0 +1,311 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I G N A L   P I P E L I N E   C L A S S                                              */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "signal_pipeline.h"
+
+// CONSTRUCTOR
+
+/// Creates a Signal Pipeline object for the given signals of a data file.
+/// The pipeline has three stages, which run concurrently:
+/// <ul>
+/// <li> A reader thread that parses the file once, and cuts every signal into fixed size sample blocks.
+/// <li> A bounded number of detector threads, each serving a slice of the signals, that append the blocks to their Signal Analyzers
+///      and search them for crest and trough candidates.
+/// <li> An analysis stage, on the calling thread, that collects the candidates of all signals.
+/// </ul>
+/// The stages are connected by bounded single-producer/single-consumer queues, so a stage that runs ahead waits for the slower one.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param signalIDList A vector containing the IDs of the signals to be extracted from the file.
+/// @param startOffset Byte offset of the first line to be read.
+/// @param endOffset Byte offset at which reading stops, the end of a line. By default the end of the file.
+/// @param detectors Number of detector threads, at most one per signal. Zero selects the number of hardware threads.
+
+Signal_Pipeline::Signal_Pipeline(const char* const signalsFileName, const vector<unsigned int>& signalIDList,
+                                 const unsigned long startOffset, const unsigned long endOffset, const unsigned int detectors)
+{
+    file_name = signalsFileName;
+    signal_ids = signalIDList;
+
+    start_offset = startOffset;
+    end_offset = endOffset;
+
+    no_detectors = detectors > 0 ? detectors : thread::hardware_concurrency();
+    no_detectors = max(1u, min(no_detectors, (unsigned int)signal_ids.size()));
+
+    for(unsigned int i=0; i<signal_ids.size(); i++)
+    {
+        sample_queues.push_back(new SPSC_Queue<Sample_Block>(PIPELINE_QUEUE_DEPTH));
+        extremum_queues.push_back(new SPSC_Queue<Extremum_Block>(PIPELINE_QUEUE_DEPTH));
+    }
+}
+
+
+// DESTRUCTOR
+
+/// Releases the queues between the pipeline stages.
+
+Signal_Pipeline::~Signal_Pipeline()
+{
+    for(unsigned int i=0; i<signal_ids.size(); i++)
+    {
+        delete sample_queues[i];
+        delete extremum_queues[i];
+    }
+}
+
+
+// void run(vector<Signal_Analyzer>&) method
+
+/// This method runs the pipeline to completion. On return every Signal Analyzer holds its signal data,
+/// and its selected crests and troughs.
+/// @param analyzers Empty Signal Analyzer objects, one per signal ID, in the same order as the signal IDs.
+
+void Signal_Pipeline::run(vector<Signal_Analyzer>& analyzers)
+{
+    if(analyzers.size() != signal_ids.size())
+    {
+        cerr << "SignalAnalyzer Error: SignalPipeline class." << endl
+             << "void run(vector<Signal_Analyzer>&) method" << endl
+             << "Number of analyzers: " << analyzers.size() << " and signal IDs: " << signal_ids.size() << " do not match" << endl;
+
+        exit(1);
+    }
+
+    inputFile.open(file_name.c_str(), ios::in);
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SignalPipeline class." << endl
+             << "void run(vector<Signal_Analyzer>&) method" << endl
+             << "Cannot open Parameter file: "<< file_name  << endl;
+
+        exit(1);
+    }
+    inputFile.seekg(start_offset);
+
+    vector<vector<Extremum> > candidates(signal_ids.size());
+    vector<thread> detectors;
+
+    //--Start the reader and the detectors--//
+    thread reader(&Signal_Pipeline::read_signal_blocks, this);
+    for(unsigned int k=0; k<no_detectors; k++)
+    {
+        detectors.push_back(thread(&Signal_Pipeline::detect_signal_extrema, this, ref(analyzers), k));
+    }
+
+    //--The calling thread is the analysis stage--//
+    collect_signal_extrema(candidates);
+
+    reader.join();
+    for(unsigned int i=0; i<detectors.size(); i++)
+    {
+        detectors[i].join();
+    }
+    inputFile.close();
+
+    //--The signal means are known only now, so complete the crest and trough selection--//
+    for(unsigned int i=0; i<analyzers.size(); i++)
+    {
+        analyzers[i].finish_detection(candidates[i]);
+    }
+}
+
+
+// void read_signal_blocks(void) method
+
+/// Reader stage. Parses the byte range of the data file row by row, converting only the time and the requested columns,
+/// and pushes a sample block per signal into the detector queues every PIPELINE_BLOCK_SIZE rows.
+
+void Signal_Pipeline::read_signal_blocks(void)
+{
+    Trace_Recorder::set_thread_name("reader");
+
+    const unsigned int no_of_signals = signal_ids.size();
+
+    Column_Parser parser(signal_ids);
+    vector<Sample_Block> blocks(no_of_signals);
+    vector<double> values;
+
+    string line;
+    double t;
+    unsigned long offset = start_offset;
+    double block_start = Trace_Recorder::now();
+
+    while(offset < end_offset && getline(inputFile, line))
+    {
+        offset += line.size() + 1;
+
+        //--Omitting lines containing '#', and empty lines--//
+        if(!parser.parse_line(line, t, values))
+        {
+            continue;
+        }
+
+        for(unsigned int i=0; i<no_of_signals; i++)
+        {
+            blocks[i].time.push_back(t);
+            blocks[i].signal.push_back(values[i]);
+        }
+
+        //--Hand the full blocks over to the detectors--//
+        if(blocks[0].time.size() == PIPELINE_BLOCK_SIZE)
+        {
+            Trace_Recorder::record("parse_block", "ingest", block_start);
+            Trace_Span span("wait_for_detectors", "queue");
+
+            for(unsigned int i=0; i<no_of_signals; i++)
+            {
+                blocks[i].last = false;
+                sample_queues[i]->push(blocks[i]);
+
+                blocks[i].time.clear();
+                blocks[i].signal.clear();
+                blocks[i].time.reserve(PIPELINE_BLOCK_SIZE);
+                blocks[i].signal.reserve(PIPELINE_BLOCK_SIZE);
+            }
+
+            block_start = Trace_Recorder::now();
+        }
+    }
+
+    Trace_Recorder::record("parse_block", "ingest", block_start);
+
+    //--The remaining rows travel with the end of stream mark--//
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        blocks[i].last = true;
+        sample_queues[i]->push(blocks[i]);
+    }
+}
+
+
+// void detect_signal_extrema(vector<Signal_Analyzer>&, const unsigned int) method
+
+/// Detector stage of a slice of the signals. Takes the sample blocks of its signals as they arrive, in turn, appends
+/// each to its signal, and forwards the crest and trough candidates found in it to the analysis stage. A signal whose
+/// block is not ready never holds up the others, so the reader cannot stall on a full queue this detector would drain.
+/// @param analyzers Signal Analyzer objects, one per signal ID.
+/// @param detector Index of the detector, which serves the signals detector, detector + no_detectors, ...
+
+void Signal_Pipeline::detect_signal_extrema(vector<Signal_Analyzer>& analyzers, const unsigned int detector)
+{
+    Trace_Recorder::set_thread_name("detector " + to_string(detector));
+
+    vector<unsigned int> active;
+    for(unsigned int i=detector; i<signal_ids.size(); i+=no_detectors)
+    {
+        active.push_back(i);
+    }
+
+    Sample_Block block;
+    Extremum_Block found;
+
+    //--Start of the current wait for samples, negative while there is work--//
+    double wait_start = -1.0;
+
+    while(!active.empty())
+    {
+        bool detected = false;
+
+        for(unsigned int a=0; a<active.size(); )
+        {
+            const unsigned int i = active[a];
+
+            if(!sample_queues[i]->try_pop(block))
+            {
+                a++;
+                continue;
+            }
+
+            if(wait_start >= 0.0)
+            {
+                Trace_Recorder::record("wait_for_samples", "queue", wait_start);
+                wait_start = -1.0;
+            }
+
+            {
+                Trace_Span span("detect_block", "ingest", signal_ids[i]);
+
+                analyzers[i].append_samples(block.time, block.signal);
+
+                found.extrema.clear();
+                analyzers[i].detect_candidates(found.extrema);
+                found.last = block.last;
+            }
+            extremum_queues[i]->push(found);
+            detected = true;
+
+            //--A signal at the end of its stream leaves the slice--//
+            if(block.last)
+            {
+                active.erase(active.begin() + a);
+            }
+            else
+            {
+                a++;
+            }
+        }
+
+        if(!detected)
+        {
+            if(wait_start < 0.0)
+            {
+                wait_start = Trace_Recorder::now();
+            }
+            this_thread::yield();
+        }
+    }
+}
+
+
+// void collect_signal_extrema(vector<vector<Extremum> >&) method
+
+/// Analysis stage. Collects the crest and trough candidates of every signal, as the detectors produce them,
+/// until all the detectors have reached the end of the stream.
+/// @param candidates Candidates of each signal, in time order.
+
+void Signal_Pipeline::collect_signal_extrema(vector<vector<Extremum> >& candidates)
+{
+    Trace_Span span("collect_signal_extrema", "ingest");
+
+    vector<bool> finished(signal_ids.size(), false);
+    unsigned int no_finished = 0;
+
+    Extremum_Block found;
+
+    while(no_finished < signal_ids.size())
+    {
+        bool collected = false;
+
+        for(unsigned int i=0; i<signal_ids.size(); i++)
+        {
+            if(!finished[i] && extremum_queues[i]->try_pop(found))
+            {
+                candidates[i].insert(candidates[i].end(), found.extrema.begin(), found.extrema.end());
+                collected = true;
+
+                if(found.last)
+                {
+                    finished[i] = true;
+                    no_finished++;
+                }
+            }
+        }
+
+        if(!collected)
+        {
+            this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I G N A L   P I P E L I N E   C L A S S   H E A D E R                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SIGNAL_PIPELINE_H
+#define SIGNAL_PIPELINE_H
+
+#include <functional>
+#include <climits>
+
+#include "signal_analyzer.h"
+#include "spsc_queue.h"
+
+#define PIPELINE_BLOCK_SIZE 4096
+#define PIPELINE_QUEUE_DEPTH 8
+
+//--A block of consecutive rows of one signal, handed from the reader to a detector--//
+struct Sample_Block
+{
+    vector<double> time;
+    vector<sample_type> signal;
+    bool last;
+};
+
+//--The candidates a detector found in one sample block, handed to the analysis stage--//
+struct Extremum_Block
+{
+    vector<Extremum> extrema;
+    bool last;
+};
+
+class Signal_Pipeline
+{
+public:
+    Signal_Pipeline(const char* const, const vector<unsigned int>&, const unsigned long = 0, const unsigned long = ULONG_MAX, const unsigned int = 0);
+    ~Signal_Pipeline();
+
+    void run(vector<Signal_Analyzer>&);
+
+private:
+    void read_signal_blocks(void);
+    void detect_signal_extrema(vector<Signal_Analyzer>&, const unsigned int);
+    void collect_signal_extrema(vector<vector<Extremum> >&);
+
+    string file_name;
+    fstream inputFile;
+
+    //--Byte range of the file to be read--//
+    unsigned long start_offset;
+    unsigned long end_offset;
+
+    vector<unsigned int> signal_ids;
+
+    //--Detector threads. Detector k serves the signals k, k + no_detectors, k + 2*no_detectors, ...--//
+    unsigned int no_detectors;
+
+    vector<SPSC_Queue<Sample_Block>*> sample_queues;
+    vector<SPSC_Queue<Extremum_Block>*> extremum_queues;
+};
+
+#endif // SIGNAL_PIPELINE_H
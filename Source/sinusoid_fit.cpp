@@ -0,0 +1,483 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I N U S O I D   F I T   C L A S S                                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "sinusoid_fit.h"
+
+// CONSTRUCTOR
+
+/// Creates a Sinusoid Fit object for all the signals on the data file.
+/// @param signalsFileName Path and name of the file containing signals data.
+
+Sinusoid_Fit::Sinusoid_Fit(const char* signalsFileName)
+{
+    if(!signalsFileName)
+    {
+        signalsFileName = "../Data/signals.dat";
+    }
+    signals_file_name = signalsFileName;
+
+    const unsigned int no_of_signals = count_signals(signalsFileName);
+    if(!no_of_signals)
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "Sinusoid_Fit(const char*) method" << endl
+             << "No signals found on file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        signal_ids.push_back(i+1);
+    }
+
+    frequency = 0.0;
+    no_samples = 0;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a Sinusoid Fit object for the given signals of the data file.
+/// @param signalsFileName Path and name of the file containing signals data.
+/// @param signalIDList A vector containing the IDs of the signals to be fitted.
+
+Sinusoid_Fit::Sinusoid_Fit(const char* signalsFileName, const vector<unsigned int>& signalIDList)
+{
+    if(!signalsFileName)
+    {
+        signalsFileName = "../Data/signals.dat";
+    }
+    signals_file_name = signalsFileName;
+
+    if(signalIDList.empty())
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "Sinusoid_Fit(const char*, const vector<unsigned int>&) method" << endl
+             << "Empty signal ID list" << endl;
+
+        exit(1);
+    }
+    signal_ids = signalIDList;
+
+    frequency = 0.0;
+    no_samples = 0;
+}
+
+
+// unsigned int count_signals(const char* const) const method
+
+/// This method returns the number of signals on the data file, from the first line that is not a comment.
+/// @param signalsFileName Path and name of the file containing signals data.
+
+unsigned int Sinusoid_Fit::count_signals(const char* const signalsFileName) const
+{
+    unsigned int num_signals = 0;
+
+    fstream inputFile;
+    inputFile.open(signalsFileName, ios::in);
+
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "count_signals(const char* const) method" << endl
+             << "Cannot open Parameter file: "<< signalsFileName  << endl;
+
+        exit(1);
+    }
+
+    string line;
+    double dNum;
+
+    //--Omitting lines containing '#'--//
+    while(getline(inputFile, line) && line.find('#') != string::npos);
+
+    stringstream ssLine(line);
+    ssLine >> dNum;
+
+    while(ssLine >> dNum)
+    {
+        num_signals++;
+    }
+
+    cout << endl << "Number of signals on file: " << num_signals << endl << endl;
+    inputFile.close();
+
+    return num_signals;
+}
+
+
+// void fit(const double, const double, const double) method
+
+/// This method fits every signal within the time window [t0,t1] to a sinusoid of the shared frequency.
+/// If no frequency is given, it is first estimated from the mean crossings of the first signal,
+/// which costs one more pass over the file reading only that column.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+/// @param freq Frequency of the signals in Hz, or 0 to estimate it.
+
+void Sinusoid_Fit::fit(const double t0, const double t1, const double freq)
+{
+    frequency = freq > 0.0 ? freq : estimate_frequency(t0, t1);
+
+    accumulate_sums(t0, t1);
+    solve_parameters();
+}
+
+
+// double estimate_frequency(const double, const double) const method
+
+/// This method estimates the shared frequency from the upward crossings of the mean by the first signal within [t0,t1].
+/// A crossing only counts after the signal has been below the mean by FIT_CROSSING_HYSTERESIS standard deviations.
+/// The number of cycles between the first and the last crossing is rounded from the median interval between crossings,
+/// so single missed or spurious crossings, from spikes or plateaus, do not bias the estimate.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+
+double Sinusoid_Fit::estimate_frequency(const double t0, const double t1) const
+{
+    fstream inputFile;
+    inputFile.open(signals_file_name, ios::in);
+
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "double estimate_frequency(const double, const double) const method" << endl
+             << "Cannot open Parameter file: "<< signals_file_name  << endl;
+
+        exit(1);
+    }
+
+    Column_Parser parser(vector<unsigned int>(1, signal_ids[0]));
+
+    string line;
+    double t;
+    vector<double> values;
+
+    //--First pass: running mean and variance of the window (Welford)--//
+    unsigned int no_samples = 0;
+    double mean = 0.0;
+    double variance = 0.0;
+
+    while(getline(inputFile, line))
+    {
+        if(parser.parse_line(line, t, values) && t >= t0 && t <= t1)
+        {
+            no_samples++;
+
+            const double delta = values[0] - mean;
+            mean += delta/no_samples;
+            variance += delta * (values[0] - mean);
+        }
+    }
+    const double hysteresis = FIT_CROSSING_HYSTERESIS * sqrt(variance/no_samples);
+
+    //--Second pass: interpolated times of the upward crossings of the mean--//
+    inputFile.clear();
+    inputFile.seekg(0, ios::beg);
+
+    vector<double> crossing;
+    bool armed = false;
+    bool started = false;
+    double previous_time = 0.0;
+    double previous_value = 0.0;
+
+    while(getline(inputFile, line))
+    {
+        if(!parser.parse_line(line, t, values) || t < t0 || t > t1)
+        {
+            continue;
+        }
+
+        const double value = values[0];
+
+        if(!started)
+        {
+            started = true;
+        }
+        else if(value < mean - hysteresis)
+        {
+            armed = true;
+        }
+        else if(armed && previous_value < mean && value >= mean)
+        {
+            crossing.push_back(previous_time + (t - previous_time) * (mean - previous_value)/(value - previous_value));
+            armed = false;
+        }
+
+        previous_time = t;
+        previous_value = value;
+    }
+    inputFile.close();
+
+    if(crossing.size() < 3)
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "double estimate_frequency(const double, const double) const method" << endl
+             << "Signal_" << signal_ids[0] << " crosses its mean less than 3 times within [" << t0 << "," << t1 << "]" << endl;
+
+        exit(1);
+    }
+
+    vector<double> interval;
+    for(unsigned int i=1; i<crossing.size(); i++)
+    {
+        interval.push_back(crossing[i] - crossing[i-1]);
+    }
+    nth_element(interval.begin(), interval.begin() + interval.size()/2, interval.end());
+
+    const double span = crossing.back() - crossing.front();
+    const double cycles = floor(span/interval[interval.size()/2] + 0.5);
+
+    return cycles/span;
+}
+
+
+// void accumulate_sums(const double, const double) method
+
+/// This method reads the file once and adds every sample within [t0,t1] to the running sums of its signal.
+/// The sine and cosine of each row are shared by all the signals, and the sums of all the signals are
+/// contiguous, so each row is a single sweep over a small array.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+
+void Sinusoid_Fit::accumulate_sums(const double t0, const double t1)
+{
+    fstream inputFile;
+    inputFile.open(signals_file_name, ios::in);
+
+    if(!inputFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "void accumulate_sums(const double, const double) method" << endl
+             << "Cannot open Parameter file: "<< signals_file_name  << endl;
+
+        exit(1);
+    }
+
+    const unsigned int no_of_signals = signal_ids.size();
+    const double omega = 2.0 * M_PI * frequency;
+
+    Column_Parser parser(signal_ids);
+
+    Sinusoid_Sums zero = {0.0, 0.0, 0.0, 0.0};
+    sums.assign(no_of_signals, zero);
+
+    no_samples = 0;
+    sum_cos = 0.0;
+    sum_sin = 0.0;
+    sum_cos_cos = 0.0;
+    sum_cos_sin = 0.0;
+    sum_sin_sin = 0.0;
+
+    string line;
+    double t;
+    vector<double> values;
+
+    while(getline(inputFile, line))
+    {
+        if(!parser.parse_line(line, t, values) || t < t0 || t > t1)
+        {
+            continue;
+        }
+
+        const double c = cos(omega * t);
+        const double s = sin(omega * t);
+
+        no_samples++;
+        sum_cos += c;
+        sum_sin += s;
+        sum_cos_cos += c * c;
+        sum_cos_sin += c * s;
+        sum_sin_sin += s * s;
+
+        for(unsigned int i=0; i<no_of_signals; i++)
+        {
+            const double x = values[i];
+
+            sums[i].x += x;
+            sums[i].x_cos += x * c;
+            sums[i].x_sin += x * s;
+            sums[i].x_x += x * x;
+        }
+    }
+    inputFile.close();
+}
+
+
+// void solve_parameters(void) method
+
+/// This method solves the 3x3 normal equations of every signal. The matrix depends only on the time axis,
+/// so it is inverted once and applied to the sums of each signal.
+
+void Sinusoid_Fit::solve_parameters(void)
+{
+    //--Symmetric normal matrix [n, Σc, Σs; Σc, Σcc, Σcs; Σs, Σcs, Σss]--//
+    const double n = no_samples;
+    const double a00 = n;
+    const double a01 = sum_cos;
+    const double a02 = sum_sin;
+    const double a11 = sum_cos_cos;
+    const double a12 = sum_cos_sin;
+    const double a22 = sum_sin_sin;
+
+    //--Adjugate, which is symmetric as well--//
+    const double c00 = a11*a22 - a12*a12;
+    const double c01 = a02*a12 - a01*a22;
+    const double c02 = a01*a12 - a02*a11;
+    const double c11 = a00*a22 - a02*a02;
+    const double c12 = a01*a02 - a00*a12;
+    const double c22 = a00*a11 - a01*a01;
+
+    const double det = a00*c00 + a01*c01 + a02*c02;
+
+    if(no_samples < 3 || fabs(det) <= 1e-9 * n * n * n)
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "void solve_parameters(void) method" << endl
+             << "Cannot fit a sinusoid of " << frequency << " Hz to " << no_samples << " samples" << endl;
+
+        exit(1);
+    }
+
+    parameters.resize(sums.size());
+
+    for(unsigned int i=0; i<sums.size(); i++)
+    {
+        const double offset = (c00*sums[i].x + c01*sums[i].x_cos + c02*sums[i].x_sin)/det;
+        const double a = (c01*sums[i].x + c11*sums[i].x_cos + c12*sums[i].x_sin)/det;
+        const double b = (c02*sums[i].x + c12*sums[i].x_cos + c22*sums[i].x_sin)/det;
+
+        //--offset + a*cos(wt) + b*sin(wt) = offset + R*sin(wt + phase)--//
+        parameters[i].offset = offset;
+        parameters[i].amplitude = sqrt(a*a + b*b);
+        parameters[i].phase = atan2(a, b) * 180.0/M_PI;
+
+        //--Residual sum of squares of the least-squares solution: Σx² - β·(Σx, Σxc, Σxs)--//
+        const double residual = sums[i].x_x - (offset*sums[i].x + a*sums[i].x_cos + b*sums[i].x_sin);
+        parameters[i].residual = sqrt(max(residual, 0.0)/n);
+    }
+}
+
+
+// void show_signal_amplitudes(void) const method
+
+/// Displays the fitted amplitude of all the signals.
+
+void Sinusoid_Fit::show_signal_amplitudes(void) const
+{
+    cout << endl << "         Signal Amplitudes (least-squares fit)" << endl;
+    for(unsigned int i=0; i<parameters.size(); i++)
+    {
+        cout << "Signal_" << signal_ids[i] << ": " << parameters[i].amplitude << endl;
+    }
+}
+
+
+// void show_signal_offsets(void) const method
+
+/// Displays the fitted offset of all the signals.
+
+void Sinusoid_Fit::show_signal_offsets(void) const
+{
+    cout << endl << "         Signal Offsets (least-squares fit)" << endl;
+    for(unsigned int i=0; i<parameters.size(); i++)
+    {
+        cout << "Signal_" << signal_ids[i] << ": " << parameters[i].offset << endl;
+    }
+}
+
+
+// void show_phase_relation(void) const method
+
+/// Displays the phase difference between every pair of signals, with the same sign convention as
+/// the crest and trough based phase differences of Signal_Analyzer_List.
+
+void Sinusoid_Fit::show_phase_relation(void) const
+{
+    cout << endl << "         Least-squares phase difference between pairs of signals (-180°, 180°]" << endl;
+    for(unsigned int i=0; i+1<parameters.size(); i++)
+    {
+        for(unsigned int j=i+1; j<parameters.size(); j++)
+        {
+            cout << "Signal_" << signal_ids[i] << " AND Signal_" << signal_ids[j] << ": "
+                 << wrap_phase_180(parameters[j].phase - parameters[i].phase) << "°" << endl;
+        }
+    }
+}
+
+
+// void show_signal_frequency(void) const method
+
+/// Displays the frequency the signals were fitted at.
+
+void Sinusoid_Fit::show_signal_frequency(void) const
+{
+    cout << endl << "Signal Frequency: " << frequency << endl;
+}
+
+
+// void show_fit_residuals(void) const method
+
+/// Displays the root mean square of the residual of every signal, the noise left once the sinusoid is removed.
+
+void Sinusoid_Fit::show_fit_residuals(void) const
+{
+    cout << endl << "         Fit Residuals (RMS) over " << no_samples << " samples" << endl;
+    for(unsigned int i=0; i<parameters.size(); i++)
+    {
+        cout << "Signal_" << signal_ids[i] << ": " << parameters[i].residual << endl;
+    }
+}
+
+
+// unsigned int get_no_of_signals(void) const method
+
+/// This method returns the number of fitted signals.
+
+unsigned int Sinusoid_Fit::get_no_of_signals(void) const
+{
+    return signal_ids.size();
+}
+
+
+// const Sinusoid_Parameters& get_parameters(const unsigned int) const method
+
+/// This method returns the fitted parameters of a signal.
+/// @param i Position of the signal on the signal ID list.
+
+const Sinusoid_Parameters& Sinusoid_Fit::get_parameters(const unsigned int i) const
+{
+    if(i >= parameters.size())
+    {
+        cerr << "SignalAnalyzer Error: SinusoidFit class." << endl
+             << "const Sinusoid_Parameters& get_parameters(const unsigned int) const method" << endl
+             << "No fitted parameters for signal position " << i << endl;
+
+        exit(1);
+    }
+
+    return parameters[i];
+}
+
+
+// double get_frequency(void) const method
+
+/// This method returns the frequency the signals were fitted at.
+
+double Sinusoid_Fit::get_frequency(void) const
+{
+    return frequency;
+}
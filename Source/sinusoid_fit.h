@@ -0,0 +1,90 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S I N U S O I D   F I T   C L A S S   H E A D E R                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SINUSOID_FIT_H
+#define SINUSOID_FIT_H
+
+#include "signal_analyzer.h"
+
+//--Half width of the band around the mean a signal must leave before a mean crossing counts, in standard deviations--//
+#define FIT_CROSSING_HYSTERESIS 0.5
+
+//--Running sums of one signal against the sine and cosine of the shared frequency--//
+struct Sinusoid_Sums
+{
+    double x;
+    double x_cos;
+    double x_sin;
+    double x_x;
+};
+
+//--Fitted model of one signal: offset + amplitude*sin(2*pi*frequency*t + phase)--//
+struct Sinusoid_Parameters
+{
+    double amplitude;
+    double offset;
+    double phase;       // Degrees at t = 0
+    double residual;    // Root mean square of the residual
+};
+
+/// Alternative estimation engine to the crest and trough pipeline of Signal_Analyzer_List.
+/// As all the signals share one frequency, each signal is fitted by linear least squares to
+/// offset + a*cos(wt) + b*sin(wt). The file is read once, all the columns at a time, and only
+/// a few running sums per signal are kept. There is no peak detection and no filtering across
+/// signals, so noise and spikes are averaged out instead of producing false extrema.
+
+class Sinusoid_Fit
+{
+public:
+    Sinusoid_Fit(const char*);
+    Sinusoid_Fit(const char*, const vector<unsigned int>&);
+
+    void fit(const double, const double, const double = 0.0);
+
+    void show_signal_amplitudes(void) const;
+    void show_signal_offsets(void) const;
+    void show_phase_relation(void) const;
+    void show_signal_frequency(void) const;
+    void show_fit_residuals(void) const;
+
+    unsigned int get_no_of_signals(void) const;
+    const Sinusoid_Parameters& get_parameters(const unsigned int) const;
+    double get_frequency(void) const;
+
+private:
+    unsigned int count_signals(const char* const) const;
+
+    double estimate_frequency(const double, const double) const;
+    void accumulate_sums(const double, const double);
+    void solve_parameters(void);
+
+    const char* signals_file_name;
+    vector<unsigned int> signal_ids;
+
+    double frequency;
+
+    //--Sums shared by all the signals, as they share the time axis--//
+    unsigned int no_samples;
+    double sum_cos;
+    double sum_sin;
+    double sum_cos_cos;
+    double sum_cos_sin;
+    double sum_sin_sin;
+
+    vector<Sinusoid_Sums> sums;
+    vector<Sinusoid_Parameters> parameters;
+};
+
+#endif // SINUSOID_FIT_H
@@ -0,0 +1,198 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S L I D I N G   M E D I A N   C L A S S                                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "sliding_median.h"
+
+// CONSTRUCTOR
+
+/// Creates an empty Sliding Median object.
+/// @param prefilter_options Median or Hampel filter, window length and Hampel threshold.
+
+Sliding_Median::Sliding_Median(const Prefilter_Options& prefilter_options) : options(prefilter_options)
+{
+    if(options.mode != NO_PREFILTER && (options.window < 3 || options.window % 2 == 0))
+    {
+        cerr << "SignalAnalyzer Error: SlidingMedian class." << endl
+             << "Sliding_Median(const Prefilter_Options&) method" << endl
+             << "Window must be an odd number of samples, at least 3: " << options.window << endl;
+
+        exit(1);
+    }
+    else if(options.mode != NO_PREFILTER && options.window > PREFILTER_MAX_WINDOW)
+    {
+        cerr << "SignalAnalyzer Error: SlidingMedian class." << endl
+             << "Sliding_Median(const Prefilter_Options&) method" << endl
+             << "Window must be at most " << PREFILTER_MAX_WINDOW << " samples: " << options.window << endl;
+
+        exit(1);
+    }
+
+    half = options.window/2;
+    oldest = 0;
+    no_replaced = 0;
+
+    if(options.mode != NO_PREFILTER)
+    {
+        window.reserve(options.window);
+        sorted.reserve(options.window);
+    }
+}
+
+
+// bool push(const double, double&) method
+
+/// This method adds a sample to the window, dropping the oldest one once the window is full.
+/// Returns true, with the filtered value of the sample at the centre of the window, if the window is full.
+/// @param value Value of the new sample.
+/// @param filtered Filtered value of the sample pushed window/2 samples earlier.
+
+bool Sliding_Median::push(const double value, double& filtered)
+{
+    if(window.size() == options.window)
+    {
+        sorted.erase(lower_bound(sorted.begin(), sorted.end(), window[oldest]));
+
+        window[oldest] = value;
+        oldest = (oldest+1) % options.window;
+    }
+    else
+    {
+        window.push_back(value);
+    }
+    sorted.insert(upper_bound(sorted.begin(), sorted.end(), value), value);
+
+    if(sorted.size() < options.window)
+    {
+        return false;
+    }
+
+    const double centre = window[(oldest+half) % options.window];
+    const double median = sorted[half];
+
+    if(options.mode == MEDIAN_PREFILTER)
+    {
+        filtered = median;
+    }
+    else if(fabs(centre - median) > options.threshold * MAD_SCALE * median_absolute_deviation(median))
+    {
+        filtered = median;
+    }
+    else
+    {
+        filtered = centre;
+    }
+
+    if(filtered != centre)
+    {
+        no_replaced++;
+    }
+
+    return true;
+}
+
+
+// double median_absolute_deviation(const double) const method
+
+/// This method returns the median of the absolute deviations of the window from its median.
+/// Below and above the median the sorted window gives two sorted runs of deviations, which are merged
+/// only up to the middle one.
+/// @param median Median of the window.
+
+double Sliding_Median::median_absolute_deviation(const double median) const
+{
+    //--The median itself is the smallest deviation, zero--//
+    unsigned int below = half;
+    unsigned int above = half+1;
+    double deviation = 0.0;
+
+    for(unsigned int k=0; k<half; k++)
+    {
+        if(median - sorted[below-1] <= sorted[above] - median)
+        {
+            deviation = median - sorted[--below];
+        }
+        else
+        {
+            deviation = sorted[above++] - median;
+        }
+    }
+
+    return deviation;
+}
+
+
+// void get_window(vector<double>&) const method
+
+/// This method returns the samples in the window, oldest first.
+/// @param samples Samples of the window.
+
+void Sliding_Median::get_window(vector<double>& samples) const
+{
+    samples.clear();
+
+    for(unsigned int i=0; i<window.size(); i++)
+    {
+        samples.push_back(window[(oldest+i) % window.size()]);
+    }
+}
+
+
+// void restore(const vector<double>&, const unsigned long) method
+
+/// This method refills an empty filter with the window returned by get_window(), so that it carries on where that filter stopped.
+/// @param samples Samples of the window, oldest first.
+/// @param replaced Number of samples that filter had changed.
+
+void Sliding_Median::restore(const vector<double>& samples, const unsigned long replaced)
+{
+    double filtered;
+
+    for(unsigned int i=0; i<samples.size(); i++)
+    {
+        push(samples[i], filtered);
+    }
+
+    no_replaced = replaced;
+}
+
+
+// unsigned int get_delay(void) const method
+
+/// This method returns the number of samples by which the filtered values lag the pushed ones, zero if the filter is off.
+
+unsigned int Sliding_Median::get_delay(void) const
+{
+    return options.mode == NO_PREFILTER ? 0 : half;
+}
+
+
+// unsigned long get_no_replaced(void) const method
+
+/// This method returns the number of samples the filter has changed.
+
+unsigned long Sliding_Median::get_no_replaced(void) const
+{
+    return no_replaced;
+}
+
+
+// const Prefilter_Options& get_options(void) const method
+
+/// This method returns the options of the filter.
+
+const Prefilter_Options& Sliding_Median::get_options(void) const
+{
+    return options;
+}
@@ -0,0 +1,91 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S L I D I N G   M E D I A N   C L A S S   H E A D E R                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SLIDING_MEDIAN_H
+#define SLIDING_MEDIAN_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include <math.h>
+
+using namespace std;
+
+//--Filter applied to every signal as it is ingested, before crests and troughs are searched for--//
+enum Prefilter_Mode
+{
+    NO_PREFILTER,
+    MEDIAN_PREFILTER,    // Every sample is replaced by the median of the window centred on it.
+    HAMPEL_PREFILTER     // Only samples further than threshold scaled MADs from the window median are replaced by it.
+};
+
+#define PREFILTER_WINDOW 7
+
+//--Every push moves up to a window of samples in the sorted copy, and the Hampel deviation scans half of it, so the
+//  cost per sample grows with the window. Up to this length it stays within twice that of the default window--//
+#define PREFILTER_MAX_WINDOW 255
+#define HAMPEL_THRESHOLD 3.0
+
+//--Scales the median absolute deviation to the standard deviation of gaussian noise--//
+#define MAD_SCALE 1.4826
+
+struct Prefilter_Options
+{
+    Prefilter_Options(const Prefilter_Mode prefilter_mode = NO_PREFILTER, const unsigned int prefilter_window = PREFILTER_WINDOW,
+                      const double hampel_threshold = HAMPEL_THRESHOLD)
+        : mode(prefilter_mode), window(prefilter_window), threshold(hampel_threshold) {}
+
+    Prefilter_Mode mode;
+    unsigned int window;        // Odd number of samples
+    double threshold;           // Hampel filter only
+};
+
+/// Streaming median or Hampel filter over a window of an odd number of samples.
+/// Samples are pushed one at a time. Once the window is full, every push returns the filtered value of
+/// the sample at the centre of the window, the one pushed window/2 samples earlier. The first and the
+/// last window/2 samples of a signal have no full window and are left as they are.
+/// The window is held both in arrival order and sorted. For the short windows used on spikes, a sorted
+/// array updated by binary search and one move beats a balanced tree, so longer windows are refused.
+
+class Sliding_Median
+{
+public:
+    Sliding_Median(const Prefilter_Options& = Prefilter_Options());
+
+    bool push(const double, double&);
+
+    void get_window(vector<double>&) const;
+    void restore(const vector<double>&, const unsigned long);
+
+    unsigned int get_delay(void) const;
+    unsigned long get_no_replaced(void) const;
+    const Prefilter_Options& get_options(void) const;
+
+private:
+    double median_absolute_deviation(const double) const;
+
+    Prefilter_Options options;
+    unsigned int half;
+
+    //--Window in arrival order, as a ring starting at oldest, and sorted--//
+    vector<double> window;
+    unsigned int oldest;
+    vector<double> sorted;
+
+    unsigned long no_replaced;
+};
+
+#endif // SLIDING_MEDIAN_H
@@ -0,0 +1,151 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   S P S C   Q U E U E   C L A S S   H E A D E R                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+#define CACHE_LINE_SIZE 64
+
+/// Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+/// The capacity is rounded up to a power of two. push() and pop() block by yielding while
+/// the queue is full or empty, which applies backpressure to the faster side.
+
+template <typename T>
+class SPSC_Queue
+{
+public:
+    explicit SPSC_Queue(const unsigned int);
+
+    bool try_push(T&);
+    bool try_pop(T&);
+
+    void push(T&);
+    void pop(T&);
+
+private:
+    vector<T> buffer;
+    unsigned long mask;
+
+    //--Producer and consumer positions live on separate cache lines. They are padded apart rather than aligned,
+    //  as plain new does not honour alignments beyond that of the largest fundamental type--//
+    char tail_padding[CACHE_LINE_SIZE];
+    atomic<unsigned long> tail;
+    char head_padding[CACHE_LINE_SIZE - sizeof(atomic<unsigned long>)];
+    atomic<unsigned long> head;
+    char end_padding[CACHE_LINE_SIZE - sizeof(atomic<unsigned long>)];
+};
+
+
+// CONSTRUCTOR
+
+/// Creates an empty queue able to hold at least the given number of elements.
+/// @param min_capacity Minimum number of elements the queue can hold.
+
+template <typename T>
+SPSC_Queue<T>::SPSC_Queue(const unsigned int min_capacity) : tail(0), head(0)
+{
+    unsigned long capacity = 1;
+    while(capacity < min_capacity)
+    {
+        capacity <<= 1;
+    }
+
+    buffer.resize(capacity);
+    mask = capacity - 1;
+}
+
+
+// bool try_push(T&) method
+
+/// Moves an element into the queue. Returns false, leaving the element untouched, if the queue is full.
+/// Must only be called from the producer thread.
+/// @param element Element to be moved into the queue.
+
+template <typename T>
+bool SPSC_Queue<T>::try_push(T& element)
+{
+    const unsigned long t = tail.load(memory_order_relaxed);
+
+    if(t - head.load(memory_order_acquire) > mask)
+    {
+        return false;
+    }
+
+    buffer[t & mask] = std::move(element);
+    tail.store(t + 1, memory_order_release);
+
+    return true;
+}
+
+
+// bool try_pop(T&) method
+
+/// Moves the oldest element of the queue into the parameter. Returns false if the queue is empty.
+/// Must only be called from the consumer thread.
+/// @param element Destination of the popped element.
+
+template <typename T>
+bool SPSC_Queue<T>::try_pop(T& element)
+{
+    const unsigned long h = head.load(memory_order_relaxed);
+
+    if(h == tail.load(memory_order_acquire))
+    {
+        return false;
+    }
+
+    element = std::move(buffer[h & mask]);
+    head.store(h + 1, memory_order_release);
+
+    return true;
+}
+
+
+// void push(T&) method
+
+/// Moves an element into the queue, waiting while the queue is full.
+/// @param element Element to be moved into the queue.
+
+template <typename T>
+void SPSC_Queue<T>::push(T& element)
+{
+    while(!try_push(element))
+    {
+        this_thread::yield();
+    }
+}
+
+
+// void pop(T&) method
+
+/// Moves the oldest element of the queue into the parameter, waiting while the queue is empty.
+/// @param element Destination of the popped element.
+
+template <typename T>
+void SPSC_Queue<T>::pop(T& element)
+{
+    while(!try_pop(element))
+    {
+        this_thread::yield();
+    }
+}
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,147 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   T H R E A D   P O O L   C L A S S                                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "thread_pool.h"
+
+// CONSTRUCTOR
+
+/// Creates a Thread Pool object and starts its worker threads.
+/// @param no_threads Number of worker threads. Zero selects the number of hardware threads.
+
+Thread_Pool::Thread_Pool(const unsigned int no_threads)
+{
+    unsigned int n = no_threads;
+
+    if(n == 0)
+    {
+        n = thread::hardware_concurrency();
+    }
+    if(n == 0)
+    {
+        n = 1;
+    }
+
+    busy_workers = 0;
+    stopping = false;
+
+    for(unsigned int i=0; i<n; i++)
+    {
+        workers.push_back(thread(&Thread_Pool::work, this));
+    }
+}
+
+
+// DESTRUCTOR
+
+/// Completes the queued tasks and stops the worker threads.
+
+Thread_Pool::~Thread_Pool()
+{
+    {
+        unique_lock<mutex> lock(task_mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+
+    for(unsigned int i=0; i<workers.size(); i++)
+    {
+        workers[i].join();
+    }
+}
+
+
+// void submit(const function<void(void)>&) method
+
+/// This method queues a task for execution by the next free worker thread.
+/// @param task Task to be executed.
+
+void Thread_Pool::submit(const function<void(void)>& task)
+{
+    {
+        unique_lock<mutex> lock(task_mutex);
+        tasks.push_back(task);
+    }
+    task_available.notify_one();
+}
+
+
+// void wait(void) method
+
+/// This method blocks until every submitted task has been executed.
+
+void Thread_Pool::wait(void)
+{
+    unique_lock<mutex> lock(task_mutex);
+
+    while(!tasks.empty() || busy_workers != 0)
+    {
+        tasks_done.wait(lock);
+    }
+}
+
+
+// unsigned int get_num_threads(void) const method
+
+/// This method returns the number of worker threads of the pool.
+
+unsigned int Thread_Pool::get_num_threads(void) const
+{
+    return workers.size();
+}
+
+
+// void work(void) method
+
+/// Loop of a worker thread. Executes queued tasks until the pool is destroyed.
+
+void Thread_Pool::work(void)
+{
+    Trace_Recorder::set_thread_name("pool worker");
+
+    function<void(void)> task;
+
+    while(true)
+    {
+        {
+            unique_lock<mutex> lock(task_mutex);
+
+            while(tasks.empty() && !stopping)
+            {
+                task_available.wait(lock);
+            }
+
+            if(tasks.empty())
+            {
+                return;
+            }
+
+            task = tasks.front();
+            tasks.pop_front();
+            busy_workers++;
+        }
+
+        task();
+
+        {
+            unique_lock<mutex> lock(task_mutex);
+            busy_workers--;
+
+            if(tasks.empty() && busy_workers == 0)
+            {
+                tasks_done.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   T H R E A D   P O O L   C L A S S   H E A D E R                                        */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "trace_recorder.h"
+
+using namespace std;
+
+class Thread_Pool
+{
+public:
+    Thread_Pool(const unsigned int = 0);
+    ~Thread_Pool();
+
+    void submit(const function<void(void)>&);
+    void wait(void);
+
+    unsigned int get_num_threads(void) const;
+
+private:
+    void work(void);
+
+    vector<thread> workers;
+    deque<function<void(void)> > tasks;
+
+    mutex task_mutex;
+    condition_variable task_available;
+    condition_variable tasks_done;
+
+    unsigned int busy_workers;
+    bool stopping;
+};
+
+#endif // THREAD_POOL_H
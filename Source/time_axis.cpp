@@ -0,0 +1,169 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   T I M E   A X I S   C L A S S                                                          */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "time_axis.h"
+
+// CONSTRUCTOR
+
+/// Creates an empty Time Axis object.
+/// While the appended time values follow a fixed step, within UNIFORM_TIME_TOLERANCE, the axis is held as (t0, dt)
+/// and each time value is computed on demand. At the first value off that grid the axis falls back to an
+/// explicit column of time values.
+
+Time_Axis::Time_Axis(void)
+{
+    clear();
+}
+
+
+// void push_back(const double) method
+
+/// This method appends a time value to the end of the axis.
+/// @param t Time value.
+
+void Time_Axis::push_back(const double t)
+{
+    if(uniform)
+    {
+        if(no_samples == 0)
+        {
+            t0 = t;
+        }
+        else if(no_samples == 1 && t > t0)
+        {
+            dt = t - t0;
+        }
+        else if(no_samples == 1 || fabs(t - (t0 + no_samples*dt)) > UNIFORM_TIME_TOLERANCE*dt)
+        {
+            //--Irregular sampling: materialize the time values so far--//
+            explicit_time.reserve(2*no_samples);
+            for(unsigned int i=0; i<no_samples; i++)
+            {
+                explicit_time.push_back(t0 + i*dt);
+            }
+            uniform = false;
+        }
+    }
+
+    if(!uniform)
+    {
+        explicit_time.push_back(t);
+    }
+
+    no_samples++;
+}
+
+
+// void clear(void) method
+
+/// This method removes all time values from the axis.
+
+void Time_Axis::clear(void)
+{
+    no_samples = 0;
+    uniform = true;
+    t0 = 0.0;
+    dt = 0.0;
+
+    explicit_time.clear();
+}
+
+
+// void make_explicit(void) method
+
+/// This method stores every time value from now on as given, for axes that hold a selection of samples,
+/// whose times may happen to be evenly spaced without being on the sampling grid.
+
+void Time_Axis::make_explicit(void)
+{
+    if(uniform)
+    {
+        for(unsigned int i=0; i<no_samples; i++)
+        {
+            explicit_time.push_back(t0 + i*dt);
+        }
+        uniform = false;
+    }
+}
+
+
+// unsigned int find_index(const double) const method
+
+/// This method returns the index of the first sample at or after a time value, or the number of samples
+/// if every sample is before it.
+/// @param t Time value.
+
+unsigned int Time_Axis::find_index(const double t) const
+{
+    if(!uniform)
+    {
+        return lower_bound(explicit_time.begin(), explicit_time.end(), t) - explicit_time.begin();
+    }
+
+    if(no_samples == 0 || t <= t0)
+    {
+        return 0;
+    }
+    if(no_samples == 1 || dt <= 0.0)
+    {
+        return no_samples;
+    }
+
+    const double position = ceil((t - t0)/dt - UNIFORM_TIME_TOLERANCE);
+
+    return (position >= no_samples) ? no_samples : (unsigned int)position;
+}
+
+
+// bool is_uniform(void) const method
+
+/// This method returns true if the axis is held as a uniform grid, without an explicit column of time values.
+
+bool Time_Axis::is_uniform(void) const
+{
+    return uniform;
+}
+
+
+// double get_step(void) const method
+
+/// This method returns the sampling step. For an irregular axis this is the time between the first two samples.
+/// Returns zero if there are fewer than two samples.
+
+double Time_Axis::get_step(void) const
+{
+    if(no_samples < 2)
+    {
+        return 0.0;
+    }
+    else if(uniform)
+    {
+        return dt;
+    }
+    else
+    {
+        return explicit_time[1] - explicit_time[0];
+    }
+}
+
+
+// unsigned long get_memory_usage(void) const method
+
+/// This method returns the bytes held by the explicit column of time values, zero for a uniform axis.
+
+unsigned long Time_Axis::get_memory_usage(void) const
+{
+    return explicit_time.capacity() * sizeof(double);
+}
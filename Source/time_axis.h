@@ -0,0 +1,88 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   T I M E   A X I S   C L A S S   H E A D E R                                            */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef TIME_AXIS_H
+#define TIME_AXIS_H
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+
+using namespace std;
+
+//--Largest deviation from the uniform grid, as a fraction of the sampling step, still considered uniform--//
+#define UNIFORM_TIME_TOLERANCE 1e-3
+
+class Time_Axis
+{
+public:
+    Time_Axis(void);
+
+    void push_back(const double);
+    void clear(void);
+    void make_explicit(void);
+
+    double operator[](const unsigned int) const;
+    unsigned int size(void) const;
+
+    unsigned int find_index(const double) const;
+
+    bool is_uniform(void) const;
+    double get_step(void) const;
+    unsigned long get_memory_usage(void) const;
+
+private:
+    unsigned int no_samples;
+
+    //--Uniform axis: time[i] = t0 + i*dt--//
+    bool uniform;
+    double t0;
+    double dt;
+
+    //--Explicit axis, used only once a time value falls off the uniform grid--//
+    vector<double> explicit_time;
+};
+
+
+// double operator[](const unsigned int) const method
+
+/// This method returns the time of a sample.
+/// @param i Index of the sample.
+
+inline double Time_Axis::operator[](const unsigned int i) const
+{
+    if(uniform)
+    {
+        return t0 + i*dt;
+    }
+    else
+    {
+        return explicit_time[i];
+    }
+}
+
+
+// unsigned int size(void) const method
+
+/// This method returns the number of samples on the time axis.
+
+inline unsigned int Time_Axis::size(void) const
+{
+    return no_samples;
+}
+
+#endif // TIME_AXIS_H
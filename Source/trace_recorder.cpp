@@ -0,0 +1,218 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   T R A C E   R E C O R D E R   C L A S S                                                */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "trace_recorder.h"
+
+//--Set once by start(), before the worker threads are created--//
+static bool trace_enabled = false;
+static chrono::steady_clock::time_point trace_origin;
+
+//--Buffers of every thread that recorded an event, owned by the recorder so that they outlive their threads--//
+static mutex buffers_mutex;
+static vector<Trace_Buffer*> buffers;
+
+static thread_local Trace_Buffer* thread_buffer = NULL;
+
+
+// void start(void) method
+
+/// This method starts recording. It must be called before the threads to be traced are created.
+
+void Trace_Recorder::start(void)
+{
+    trace_origin = chrono::steady_clock::now();
+    trace_enabled = true;
+
+    set_thread_name("main");
+}
+
+
+// bool is_enabled(void) method
+
+/// This method returns true once the recorder has been started.
+
+bool Trace_Recorder::is_enabled(void)
+{
+    return trace_enabled;
+}
+
+
+// double now(void) method
+
+/// This method returns the microseconds elapsed since the recorder was started.
+
+double Trace_Recorder::now(void)
+{
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - trace_origin).count();
+}
+
+
+// void record(const char* const, const char* const, const double, const int, const int) method
+
+/// This method records a span from the given start time until now, on the calling thread.
+/// @param name Name of the span, a string literal.
+/// @param category Category of the span, a string literal.
+/// @param start Start time of the span, as returned by now().
+/// @param signal Signal ID the span works on, -1 if none.
+/// @param reference Second signal ID of a pair, -1 if none.
+
+void Trace_Recorder::record(const char* const name, const char* const category, const double start, const int signal, const int reference)
+{
+    if(!trace_enabled)
+    {
+        return;
+    }
+
+    Trace_Event event;
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.duration = now() - start;
+    event.signal = signal;
+    event.reference = reference;
+
+    get_buffer().events.push_back(event);
+}
+
+
+// void set_thread_name(const string&) method
+
+/// This method names the track of the calling thread.
+/// @param name Name of the thread.
+
+void Trace_Recorder::set_thread_name(const string& name)
+{
+    if(trace_enabled)
+    {
+        get_buffer().thread_name = name;
+    }
+}
+
+
+// Trace_Buffer& get_buffer(void) method
+
+/// This method returns the buffer of the calling thread, registering it on the first call from the thread.
+
+Trace_Buffer& Trace_Recorder::get_buffer(void)
+{
+    if(!thread_buffer)
+    {
+        lock_guard<mutex> lock(buffers_mutex);
+
+        thread_buffer = new Trace_Buffer;
+        thread_buffer->thread_index = buffers.size();
+        buffers.push_back(thread_buffer);
+    }
+
+    return *thread_buffer;
+}
+
+
+// unsigned long save(const char* const) method
+
+/// This method saves every recorded span as a Chrome trace event file, and returns the number of spans.
+/// The threads that recorded them must have been joined.
+/// @param file_name Path and name of the trace file.
+
+unsigned long Trace_Recorder::save(const char* const file_name)
+{
+    ofstream traceFile(file_name);
+    if(!traceFile.is_open())
+    {
+        cerr << "SignalAnalyzer Error: TraceRecorder class." << endl
+             << "unsigned long save(const char* const) method" << endl
+             << "Cannot open trace file: " << file_name << endl;
+
+        exit(1);
+    }
+
+    lock_guard<mutex> lock(buffers_mutex);
+
+    unsigned long no_events = 0;
+    bool first = true;
+
+    traceFile.setf(ios::fixed);
+    traceFile.precision(3);
+    traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for(unsigned int b=0; b<buffers.size(); b++)
+    {
+        const Trace_Buffer& buffer = *buffers[b];
+
+        //--Track name of the thread--//
+        if(!buffer.thread_name.empty())
+        {
+            traceFile << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.thread_index
+                      << ",\"args\":{\"name\":\"" << buffer.thread_name << "\"}}";
+            first = false;
+        }
+
+        for(unsigned int e=0; e<buffer.events.size(); e++)
+        {
+            const Trace_Event& event = buffer.events[e];
+
+            traceFile << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                      << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.thread_index
+                      << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+            first = false;
+
+            if(event.signal >= 0)
+            {
+                traceFile << ",\"args\":{\"signal\":" << event.signal;
+                if(event.reference >= 0)
+                {
+                    traceFile << ",\"reference\":" << event.reference;
+                }
+                traceFile << "}";
+            }
+            traceFile << "}";
+        }
+
+        no_events += buffer.events.size();
+    }
+
+    traceFile << "\n]}" << endl;
+    traceFile.close();
+
+    return no_events;
+}
+
+
+// CONSTRUCTOR
+
+/// Creates a Trace Span object, starting the span if the recorder has been started.
+/// @param span_name Name of the span, a string literal.
+/// @param span_category Category of the span, a string literal.
+/// @param signal_id Signal ID the span works on, -1 if none.
+/// @param reference_id Second signal ID of a pair, -1 if none.
+
+Trace_Span::Trace_Span(const char* const span_name, const char* const span_category, const int signal_id, const int reference_id)
+    : name(span_name), category(span_category), signal(signal_id), reference(reference_id)
+{
+    start = Trace_Recorder::is_enabled() ? Trace_Recorder::now() : 0.0;
+}
+
+
+// DESTRUCTOR
+
+/// Ends the span, recording it.
+
+Trace_Span::~Trace_Span()
+{
+    if(Trace_Recorder::is_enabled())
+    {
+        Trace_Recorder::record(name, category, start, signal, reference);
+    }
+}
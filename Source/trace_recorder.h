@@ -0,0 +1,86 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   T R A C E   R E C O R D E R   C L A S S   H E A D E R                                  */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <stdlib.h>
+
+using namespace std;
+
+//--A span of work on one thread. Name and category must be string literals, as only their address is kept--//
+struct Trace_Event
+{
+    const char* name;
+    const char* category;
+    double start;           // Microseconds since the recorder was started
+    double duration;
+    int signal;             // Signal ID the span works on, -1 if none
+    int reference;          // Second signal ID of a pair, -1 if none
+};
+
+//--Events of one thread, appended only by that thread--//
+struct Trace_Buffer
+{
+    unsigned int thread_index;
+    string thread_name;
+    vector<Trace_Event> events;
+};
+
+/// Opt-in timeline of the work done on every thread, saved in the Chrome trace event format, which Perfetto
+/// (ui.perfetto.dev) and chrome://tracing display with one track per thread.
+/// Each thread appends to a buffer of its own, registered under a lock on its first event only, so recording
+/// takes no lock. The buffers are read by save() once the worker threads have been joined. When the recorder
+/// has not been started, spans cost a single test.
+
+class Trace_Recorder
+{
+public:
+    static void start(void);
+    static bool is_enabled(void);
+
+    static double now(void);
+    static void record(const char* const, const char* const, const double, const int = -1, const int = -1);
+    static void set_thread_name(const string&);
+
+    static unsigned long save(const char* const);
+
+private:
+    static Trace_Buffer& get_buffer(void);
+};
+
+/// Records the span from its construction to its destruction, on the thread that created it.
+
+class Trace_Span
+{
+public:
+    Trace_Span(const char* const, const char* const, const int = -1, const int = -1);
+    ~Trace_Span();
+
+private:
+    const char* name;
+    const char* category;
+    int signal;
+    int reference;
+    double start;
+};
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,283 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   W I N D O W   I N D E X   C L A S S                                                    */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#include "window_index.h"
+
+// CONSTRUCTOR
+
+/// Creates a Window Index over an already filtered Signal Analyzer List.
+/// Prefix sums over the crests and troughs of every signal, and over the phase difference of every pair of signals,
+/// are built once here, so that the average amplitude, offset, frequency or phase difference over any time window
+/// takes two binary searches, without cropping the signals.
+/// The index refers to the list, which must not be modified while the index is in use.
+/// @param signalList Signal Analyzer List holding the signals.
+
+Window_Index::Window_Index(const Signal_Analyzer_List& signalList) : sList(signalList)
+{
+    const unsigned int no_of_signals = sList.get_no_of_signals();
+
+    crest_prefix.resize(no_of_signals);
+    trough_prefix.resize(no_of_signals);
+
+    for(unsigned int i=0; i<no_of_signals; i++)
+    {
+        build_extrema_prefix(sList.get_signal(i), CREST_BASIS, crest_prefix[i]);
+        build_extrema_prefix(sList.get_signal(i), TROUGH_BASIS, trough_prefix[i]);
+    }
+
+    vector<vector<vector<double> > > crest_phase = sList.calculate_pair_phases(CREST_BASIS);
+    vector<vector<vector<double> > > trough_phase = sList.calculate_pair_phases(TROUGH_BASIS);
+
+    crest_phase_prefix.resize(crest_phase.size());
+    trough_phase_prefix.resize(trough_phase.size());
+
+    for(unsigned int p=0; p<crest_phase.size(); p++)
+    {
+        build_phase_prefix(crest_phase[p], crest_phase_prefix[p]);
+        build_phase_prefix(trough_phase[p], trough_phase_prefix[p]);
+    }
+}
+
+
+// double estimate_amplitude(const unsigned int, const double, const double) const method
+
+/// This method returns the average amplitude of a signal over the time window [t0,t1], from the crests and troughs
+/// within the window, in the same way as Signal_Analyzer::estimate_amplitude() does over the whole signal.
+/// Returns NaN if the window holds no crest or no trough.
+/// @param i Position of the signal on the list.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+
+double Window_Index::estimate_amplitude(const unsigned int i, const double t0, const double t1) const
+{
+    double crest_avg;
+    double trough_avg;
+
+    if(!extrema_average(crest_prefix[i], t0, t1, crest_avg) || !extrema_average(trough_prefix[i], t0, t1, trough_avg))
+    {
+        return NAN;
+    }
+
+    return (crest_avg-trough_avg)/2.0;
+}
+
+
+// double estimate_offset(const unsigned int, const double, const double) const method
+
+/// This method returns the average offset of a signal over the time window [t0,t1].
+/// Returns NaN if the window holds no crest or no trough.
+/// @param i Position of the signal on the list.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+
+double Window_Index::estimate_offset(const unsigned int i, const double t0, const double t1) const
+{
+    double crest_avg;
+    double trough_avg;
+
+    if(!extrema_average(crest_prefix[i], t0, t1, crest_avg) || !extrema_average(trough_prefix[i], t0, t1, trough_avg))
+    {
+        return NAN;
+    }
+
+    return (crest_avg+trough_avg)/2.0;
+}
+
+
+// double estimate_frequency(const unsigned int, const Phase_Basis, const double, const double) const method
+
+/// This method returns the average frequency of a signal over the time window [t0,t1], from the periods between
+/// consecutive crests, or troughs, that both lie within the window.
+/// Returns NaN if the window holds less than two crests, or troughs.
+/// @param i Position of the signal on the list.
+/// @param basis Whether the periods are measured between crests or troughs.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+
+double Window_Index::estimate_frequency(const unsigned int i, const Phase_Basis basis, const double t0, const double t1) const
+{
+    const Extrema_Prefix& prefix = (basis == CREST_BASIS) ? crest_prefix[i] : trough_prefix[i];
+    unsigned int begin;
+    unsigned int end;
+
+    locate_window(prefix.time, t0, t1, begin, end);
+
+    if(end < begin + 2)
+    {
+        return NAN;
+    }
+
+    return (prefix.frequency_sum[end] - prefix.frequency_sum[begin+1])/(end - begin - 1);
+}
+
+
+// double estimate_phase(const unsigned int, const unsigned int, const Phase_Basis, const double, const double, unsigned int&) const method
+
+/// This method returns the average phase difference, in (-180°,180°], of signal i W.R.T signal j over the time window [t0,t1].
+/// The average is a circular mean, so that it holds for pairs close to ±180°.
+/// Returns NaN if the window holds no phase difference sample.
+/// @param i Position of the signal on the list.
+/// @param j Position of the reference signal on the list.
+/// @param basis Whether the phase difference is calculated based on signal crests or troughs.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+/// @param count Number of phase difference samples within the window.
+
+double Window_Index::estimate_phase(const unsigned int i, const unsigned int j, const Phase_Basis basis,
+                                    const double t0, const double t1, unsigned int& count) const
+{
+    //--Phase differences are held for pairs (i, j), i < j. The reverse pair has the opposite phase--//
+    const unsigned int pair = sList.get_pair_index(min(i, j), max(i, j));
+    const Phase_Prefix& prefix = (basis == CREST_BASIS) ? crest_phase_prefix[pair] : trough_phase_prefix[pair];
+    unsigned int begin;
+    unsigned int end;
+
+    locate_window(prefix.time, t0, t1, begin, end);
+    count = end - begin;
+
+    if(count == 0)
+    {
+        return NAN;
+    }
+
+    double avg_phase = atan2(prefix.sin_sum[end] - prefix.sin_sum[begin], prefix.cos_sum[end] - prefix.cos_sum[begin]) * 180.0/M_PI;
+    if(i > j)
+    {
+        avg_phase = -avg_phase;
+    }
+
+    return wrap_phase_180(avg_phase);
+}
+
+
+// void build_extrema_prefix(const Signal_Analyzer&, const Phase_Basis, Extrema_Prefix&) const method
+
+/// This method builds the prefix sums over the crests or troughs of a signal.
+/// @param signal Signal Analyzer holding the extrema.
+/// @param basis Whether the prefix sums are built over crests or troughs.
+/// @param prefix Prefix sums to be built.
+
+void Window_Index::build_extrema_prefix(const Signal_Analyzer& signal, const Phase_Basis basis, Extrema_Prefix& prefix) const
+{
+    const unsigned int count = (basis == CREST_BASIS) ? signal.get_crest_time_size() : signal.get_trough_time_size();
+
+    double value_sum = 0.0;
+    double value_compensation = 0.0;
+    double frequency_sum = 0.0;
+    double frequency_compensation = 0.0;
+
+    prefix.time.resize(count);
+    prefix.value_sum.resize(count+1);
+    prefix.frequency_sum.resize(count+1);
+
+    prefix.value_sum[0] = 0.0;
+    prefix.frequency_sum[0] = 0.0;
+
+    for(unsigned int k=0; k<count; k++)
+    {
+        prefix.time[k] = (basis == CREST_BASIS) ? signal.get_crest_time(k) : signal.get_trough_time(k);
+
+        compensated_add(value_sum, value_compensation, (basis == CREST_BASIS) ? signal.get_crest_value(k) : signal.get_trough_value(k));
+        if(k > 0)
+        {
+            //--frequency = 1.0/period--//
+            compensated_add(frequency_sum, frequency_compensation, 1.0/(prefix.time[k] - prefix.time[k-1]));
+        }
+
+        prefix.value_sum[k+1] = value_sum + value_compensation;
+        prefix.frequency_sum[k+1] = frequency_sum + frequency_compensation;
+    }
+}
+
+
+// void build_phase_prefix(const vector<vector<double> >&, Phase_Prefix&) const method
+
+/// This method builds the prefix sums over the phase difference vector of a pair of signals.
+/// @param phase Phase difference vector, with time, phase in (-180°,180°] and phase in [0°,360°) on each row.
+/// @param prefix Prefix sums to be built.
+
+void Window_Index::build_phase_prefix(const vector<vector<double> >& phase, Phase_Prefix& prefix) const
+{
+    double sin_sum = 0.0;
+    double sin_compensation = 0.0;
+    double cos_sum = 0.0;
+    double cos_compensation = 0.0;
+
+    prefix.time.resize(phase.size());
+    prefix.sin_sum.resize(phase.size()+1);
+    prefix.cos_sum.resize(phase.size()+1);
+
+    prefix.sin_sum[0] = 0.0;
+    prefix.cos_sum[0] = 0.0;
+
+    for(unsigned int k=0; k<phase.size(); k++)
+    {
+        prefix.time[k] = phase[k][0];
+
+        compensated_add(sin_sum, sin_compensation, sin(phase[k][2] * M_PI/180.0));
+        compensated_add(cos_sum, cos_compensation, cos(phase[k][2] * M_PI/180.0));
+
+        prefix.sin_sum[k+1] = sin_sum + sin_compensation;
+        prefix.cos_sum[k+1] = cos_sum + cos_compensation;
+    }
+}
+
+
+// bool extrema_average(const Extrema_Prefix&, const double, const double, double&) const method
+
+/// This method calculates the average value of the crests or troughs within the time window [t0,t1].
+/// Returns false if the window holds no extremum.
+/// @param prefix Prefix sums over the crests or troughs.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+/// @param average Average value of the extrema within the window.
+
+bool Window_Index::extrema_average(const Extrema_Prefix& prefix, const double t0, const double t1, double& average) const
+{
+    unsigned int begin;
+    unsigned int end;
+
+    locate_window(prefix.time, t0, t1, begin, end);
+
+    if(end == begin)
+    {
+        return false;
+    }
+
+    average = (prefix.value_sum[end] - prefix.value_sum[begin])/(end - begin);
+
+    return true;
+}
+
+
+// void locate_window(const vector<double>&, const double, const double, unsigned int&, unsigned int&) const method
+
+/// This method locates the time window [t0,t1] on a sorted time vector by binary search.
+/// @param time Sorted time vector.
+/// @param t0 Start time of the window.
+/// @param t1 End time of the window.
+/// @param begin Position of the first time within the window.
+/// @param end Position past the last time within the window.
+
+void Window_Index::locate_window(const vector<double>& time, const double t0, const double t1, unsigned int& begin, unsigned int& end) const
+{
+    begin = lower_bound(time.begin(), time.end(), t0) - time.begin();
+    end = upper_bound(time.begin(), time.end(), t1) - time.begin();
+
+    if(end < begin)
+    {
+        end = begin;
+    }
+}
@@ -0,0 +1,65 @@
+/********************************************************************************************/
+/*                                                                                          */
+/*   SignalAnalyzer: A project for extracting signal parameters from raw signal data.       */
+/*                                                                                          */
+/*   W I N D O W   I N D E X   C L A S S   H E A D E R                                      */
+/*                                                                                          */
+/*   Avinash Ranganath                                                                      */
+/*   Robotics Lab, Department of Systems Engineering and Automation                         */
+/*   University Carlos III of Mardid(UC3M)                                                  */
+/*   Madrid, Spain                                                                          */
+/*   E-mail: nash911@gmail.com                                                              */
+/*   http://roboticslab.uc3m.es/roboticslab/persona.php?id_pers=104                         */
+/*                                                                                          */
+/********************************************************************************************/
+
+#ifndef WINDOW_INDEX_H
+#define WINDOW_INDEX_H
+
+#include "signal_analyzer_list.h"
+
+//--Prefix sums over the crests or troughs of a signal, keyed by extremum time.
+//  value_sum[k] is the sum of the values of extrema 0..k-1, and frequency_sum[k] the sum of
+//  1/period of extrema 1..k-1, each W.R.T the preceding extremum--//
+struct Extrema_Prefix
+{
+    vector<double> time;
+    vector<double> value_sum;
+    vector<double> frequency_sum;
+};
+
+//--Prefix sums of the sine and cosine of the phase difference samples of a pair of signals--//
+struct Phase_Prefix
+{
+    vector<double> time;
+    vector<double> sin_sum;
+    vector<double> cos_sum;
+};
+
+class Window_Index
+{
+public:
+    Window_Index(const Signal_Analyzer_List&);
+
+    double estimate_amplitude(const unsigned int, const double, const double) const;
+    double estimate_offset(const unsigned int, const double, const double) const;
+    double estimate_frequency(const unsigned int, const Phase_Basis, const double, const double) const;
+    double estimate_phase(const unsigned int, const unsigned int, const Phase_Basis, const double, const double, unsigned int&) const;
+
+private:
+    void build_extrema_prefix(const Signal_Analyzer&, const Phase_Basis, Extrema_Prefix&) const;
+    void build_phase_prefix(const vector<vector<double> >&, Phase_Prefix&) const;
+
+    bool extrema_average(const Extrema_Prefix&, const double, const double, double&) const;
+    void locate_window(const vector<double>&, const double, const double, unsigned int&, unsigned int&) const;
+
+    const Signal_Analyzer_List& sList;
+
+    vector<Extrema_Prefix> crest_prefix;
+    vector<Extrema_Prefix> trough_prefix;
+
+    vector<Phase_Prefix> crest_phase_prefix;
+    vector<Phase_Prefix> trough_phase_prefix;
+};
+
+#endif // WINDOW_INDEX_H
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Source/allocation_tracker.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/allocation_tracker.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/allocation_tracker.cpp.o.d"
+  "/root/repo/Source/analysis_daemon.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/analysis_daemon.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/analysis_daemon.cpp.o.d"
+  "/root/repo/Source/analysis_plan.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/analysis_plan.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/analysis_plan.cpp.o.d"
+  "/root/repo/Source/column_parser.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/column_parser.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/column_parser.cpp.o.d"
+  "/root/repo/Source/cycle_series.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/cycle_series.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/cycle_series.cpp.o.d"
+  "/root/repo/Source/main.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/main.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/main.cpp.o.d"
+  "/root/repo/Source/result_cache.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/result_cache.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/result_cache.cpp.o.d"
+  "/root/repo/Source/series_writer.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/series_writer.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/series_writer.cpp.o.d"
+  "/root/repo/Source/signal_analyzer.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer.cpp.o.d"
+  "/root/repo/Source/signal_analyzer_list.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer_list.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer_list.cpp.o.d"
+  "/root/repo/Source/signal_pipeline.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/signal_pipeline.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/signal_pipeline.cpp.o.d"
+  "/root/repo/Source/sinusoid_fit.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/sinusoid_fit.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/sinusoid_fit.cpp.o.d"
+  "/root/repo/Source/sliding_median.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/sliding_median.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/sliding_median.cpp.o.d"
+  "/root/repo/Source/thread_pool.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/thread_pool.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/thread_pool.cpp.o.d"
+  "/root/repo/Source/time_axis.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/time_axis.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/time_axis.cpp.o.d"
+  "/root/repo/Source/trace_recorder.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/trace_recorder.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/trace_recorder.cpp.o.d"
+  "/root/repo/Source/window_index.cpp" "CMakeFiles/SignalAnalyzer.dir/Source/window_index.cpp.o" "gcc" "CMakeFiles/SignalAnalyzer.dir/Source/window_index.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
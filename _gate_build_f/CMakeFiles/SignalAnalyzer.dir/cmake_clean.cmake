@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SignalAnalyzer.dir/Source/allocation_tracker.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/allocation_tracker.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/analysis_daemon.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/analysis_daemon.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/analysis_plan.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/analysis_plan.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/column_parser.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/column_parser.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/cycle_series.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/cycle_series.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/main.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/main.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/result_cache.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/result_cache.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/series_writer.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/series_writer.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer_list.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/signal_analyzer_list.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/signal_pipeline.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/signal_pipeline.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/sinusoid_fit.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/sinusoid_fit.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/sliding_median.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/sliding_median.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/thread_pool.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/thread_pool.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/time_axis.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/time_axis.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/trace_recorder.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/trace_recorder.cpp.o.d"
+  "CMakeFiles/SignalAnalyzer.dir/Source/window_index.cpp.o"
+  "CMakeFiles/SignalAnalyzer.dir/Source/window_index.cpp.o.d"
+  "SignalAnalyzer"
+  "SignalAnalyzer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SignalAnalyzer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
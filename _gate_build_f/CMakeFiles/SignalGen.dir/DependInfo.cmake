@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Source/signal_gen.cpp" "CMakeFiles/SignalGen.dir/Source/signal_gen.cpp.o" "gcc" "CMakeFiles/SignalGen.dir/Source/signal_gen.cpp.o.d"
+  "/root/repo/Source/signal_generator.cpp" "CMakeFiles/SignalGen.dir/Source/signal_generator.cpp.o" "gcc" "CMakeFiles/SignalGen.dir/Source/signal_generator.cpp.o.d"
+  "/root/repo/Source/thread_pool.cpp" "CMakeFiles/SignalGen.dir/Source/thread_pool.cpp.o" "gcc" "CMakeFiles/SignalGen.dir/Source/thread_pool.cpp.o.d"
+  "/root/repo/Source/trace_recorder.cpp" "CMakeFiles/SignalGen.dir/Source/trace_recorder.cpp.o" "gcc" "CMakeFiles/SignalGen.dir/Source/trace_recorder.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
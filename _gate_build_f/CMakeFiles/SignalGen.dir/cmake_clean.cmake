@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SignalGen.dir/Source/signal_gen.cpp.o"
+  "CMakeFiles/SignalGen.dir/Source/signal_gen.cpp.o.d"
+  "CMakeFiles/SignalGen.dir/Source/signal_generator.cpp.o"
+  "CMakeFiles/SignalGen.dir/Source/signal_generator.cpp.o.d"
+  "CMakeFiles/SignalGen.dir/Source/thread_pool.cpp.o"
+  "CMakeFiles/SignalGen.dir/Source/thread_pool.cpp.o.d"
+  "CMakeFiles/SignalGen.dir/Source/trace_recorder.cpp.o"
+  "CMakeFiles/SignalGen.dir/Source/trace_recorder.cpp.o.d"
+  "SignalGen"
+  "SignalGen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SignalGen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()